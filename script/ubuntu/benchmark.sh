@@ -0,0 +1,255 @@
+#! /bin/bash
+
+set -euo pipefail
+
+BASE_PATH="$(dirname "$0")/../.."
+cd "$BASE_PATH"
+
+# Usage: benchmark.sh <scenario> [size] [compiler...]
+#
+# Generates a synthetic program for the scenario, and runs every compiler
+# passed (build/Compiler by default) over it, reporting the best of RUNS
+# executions. To compare before and after a change, pass both binaries.
+SCENARIO="${1:-tokens}"
+SIZE="${2:-200000}"
+SIZES=()
+[ $# -ge 2 ] && SIZES=("$2")
+shift $(( $# < 2 ? $# : 2 ))
+COMPILERS=("$@")
+if [ ${#COMPILERS[@]} -eq 0 ]; then
+	COMPILERS=("build/Compiler")
+fi
+RUNS="${RUNS:-3}"
+
+WORKSPACE="$(mktemp --directory)"
+trap 'rm --force --recursive "$WORKSPACE"' EXIT
+PROGRAM="$WORKSPACE/program"
+
+# Token throughput: SIZE textblocks with two properties each (12 tokens per
+# object), plus a single slide, so the cost is dominated by the frontend.
+generate_tokens() {
+	{
+		echo "Presentation benchmark {"
+		echo "Objects {"
+		echo "Slide slide1 { }"
+		for (( k = 0; k < SIZE; ++k )); do
+			echo "Textblock t$k { font-size: 12px; color: red; }"
+		done
+		echo "}"
+		echo "Structure {"
+		echo "slide1 { add t0 with \"text\"; }"
+		echo "}"
+		echo "}"
+	} > "$PROGRAM"
+	TOKENS=$(( 12 * SIZE + 22 ))
+}
+
+# Input and string handling: SIZE slides, each with a textblock added with a
+# 1 KiB string (16 tokens per slide), so most of the bytes are string bodies.
+generate_strings() {
+	local text="$(printf 'Lorem ipsum dolor sit amet %.0s' {1..37})"
+	{
+		echo "Presentation benchmark {"
+		echo "Objects {"
+		for (( k = 0; k < SIZE; ++k )); do
+			echo "Slide s$k { }"
+			echo "Textblock t$k { }"
+		done
+		echo "}"
+		echo "Structure {"
+		for (( k = 0; k < SIZE; ++k )); do
+			echo "s$k { add t$k with \"${text:0:1024}\"; }"
+		done
+		echo "}"
+		echo "}"
+	} > "$PROGRAM"
+	TOKENS=$(( 16 * SIZE + 10 ))
+}
+
+# Layout of a single big slide: SIZE textblocks added to it, and each odd one
+# positioned at the right of the previous one (18 tokens per pair).
+generate_layout() {
+	{
+		echo "Presentation benchmark {"
+		echo "Objects {"
+		echo "Slide slide1 { }"
+		for (( k = 0; k < SIZE; ++k )); do
+			echo "Textblock t$k { }"
+		done
+		echo "}"
+		echo "Structure {"
+		echo "slide1 {"
+		for (( k = 0; k < SIZE; ++k )); do
+			echo "add t$k;"
+		done
+		for (( k = 1; k < SIZE; k += 2 )); do
+			echo "t$k right t$(( k - 1 ));"
+		done
+		echo "}"
+		echo "}"
+		echo "}"
+	} > "$PROGRAM"
+	TOKENS=$(( 9 * SIZE + 18 ))
+}
+
+# Many slides for the layout workers: SIZE slides with four textblocks each,
+# three of them positioned relative to the previous one (47 tokens per slide).
+generate_slides() {
+	{
+		echo "Presentation benchmark {"
+		echo "Objects {"
+		for (( k = 0; k < SIZE; ++k )); do
+			echo "Slide s$k { }"
+			echo "Textblock a$k { } Textblock b$k { } Textblock c$k { } Textblock d$k { }"
+		done
+		echo "}"
+		echo "Structure {"
+		for (( k = 0; k < SIZE; ++k )); do
+			echo "s$k { add a$k; add b$k; add c$k; add d$k; b$k right a$k; c$k below b$k; d$k left c$k; }"
+		done
+		echo "}"
+		echo "}"
+	} > "$PROGRAM"
+	TOKENS=$(( 47 * SIZE + 10 ))
+}
+
+# Code generation: SIZE slides with four textblocks, added with a 256 bytes
+# string, and an image each, and the textblocks animated in sequence (so each
+# of them gets its animation attributes).
+generate_generation() {
+	local text="$(printf 'Lorem ipsum dolor sit amet %.0s' {1..10})"
+	{
+		echo "Presentation benchmark {"
+		echo "Objects {"
+		for (( k = 0; k < SIZE; ++k )); do
+			echo "Slide s$k { }"
+			echo "Textblock a$k { } Textblock b$k { } Textblock c$k { } Textblock d$k { } Image i$k { }"
+		done
+		echo "}"
+		echo "Structure {"
+		for (( k = 0; k < SIZE; ++k )); do
+			echo "s$k { add a$k with \"${text:0:256}\"; add b$k with \"${text:0:256}\"; add c$k with \"${text:0:256}\"; add d$k with \"${text:0:256}\"; add i$k with \"images/$k.png\"; }"
+		done
+		echo "}"
+		echo "Animations {"
+		for (( k = 0; k < SIZE; ++k )); do
+			echo "s$k start then a$k appear then b$k appear then c$k appear then d$k appear then a$k disappear end repeat 1;"
+		done
+		echo "}"
+		echo "}"
+	} > "$PROGRAM"
+}
+
+# Builds the compiler with a minimum logging level compiled in (see the
+# COMPILED_LOGGING_LEVEL option), and prints the path of the binary.
+build_with_logging_level() {
+	local directory="build-logging-$1"
+	cmake -S . -B "$directory" -DCOMPILED_LOGGING_LEVEL="$1" > /dev/null
+	cmake --build "$directory" > /dev/null
+	echo "$directory/Compiler"
+}
+
+# Runs a compiler (with the rest of the arguments) over the program, and prints
+# the best wall-clock time (in seconds) of all the runs. The program is also
+# piped through the standard input, for compilers that don't take an input path.
+measure() {
+	local compiler="$(realpath "$1")"
+	local options=("${@:2}")
+	local best=""
+	for (( run = 0; run < RUNS; ++run )); do
+		local start=$(date +%s%N)
+		(cd "$WORKSPACE" && "$compiler" "${options[@]}" "$PROGRAM" < "$PROGRAM" > /dev/null 2>&1) || true
+		local end=$(date +%s%N)
+		local elapsed=$(( end - start ))
+		if [ -z "$best" ] || [ "$elapsed" -lt "$best" ]; then
+			best="$elapsed"
+		fi
+	done
+	awk -v nanoseconds="$best" 'BEGIN { printf "%.3f", nanoseconds / 1e9 }'
+}
+
+case "$SCENARIO" in
+	tokens)
+		generate_tokens
+		;;
+	strings)
+		generate_strings
+		;;
+	logging)
+		# Tracing folded away by the optimizer (INFORMATION) must cost the same as
+		# no logging at all (OFF). The default build only discards the traces at
+		# runtime.
+		generate_tokens
+		if [ $# -eq 0 ]; then
+			COMPILERS=("build/Compiler" "$(build_with_logging_level INFORMATION)" "$(build_with_logging_level OFF)")
+		fi
+		;;
+	layout)
+		# The layout must scale linearly: the time per object must stay the same
+		# as the slide doubles its size.
+		echo "Scenario '$SCENARIO' (size = $SIZE, doubled twice, best of $RUNS runs)"
+		BASE_SIZE="$SIZE"
+		for compiler in "${COMPILERS[@]}"; do
+			for SIZE in "$BASE_SIZE" "$(( 2 * BASE_SIZE ))" "$(( 4 * BASE_SIZE ))"; do
+				generate_layout
+				SECONDS_ELAPSED=$(measure "$compiler")
+				awk -v name="$compiler" -v size="$SIZE" -v seconds="$SECONDS_ELAPSED" \
+					'BEGIN { printf "    %s (%d objects): %.3f s, %.2f us/object\n", name, size, seconds, seconds / size * 1e6 }'
+			done
+		done
+		echo "All done."
+		exit 0
+		;;
+	slides)
+		# The layout of the slides must scale with the workers, from one up to
+		# one for each processor.
+		generate_slides
+		BYTES=$(stat --format=%s "$PROGRAM")
+		echo "Scenario '$SCENARIO' (size = $SIZE, $BYTES bytes, $TOKENS tokens, best of $RUNS runs)"
+		for compiler in "${COMPILERS[@]}"; do
+			for (( workers = 1; workers <= $(nproc); workers *= 2 )); do
+				SECONDS_ELAPSED=$(measure "$compiler" -l "$workers")
+				awk -v name="$compiler" -v workers="$workers" -v seconds="$SECONDS_ELAPSED" -v size="$SIZE" \
+					'BEGIN { printf "    %s (%d workers): %.3f s, %.2f us/slide\n", name, workers, seconds, seconds / size * 1e6 }'
+			done
+		done
+		echo "All done."
+		exit 0
+		;;
+	generation)
+		# Throughput of the output, in MB of HTML generated per second (the
+		# whole compilation is measured, so compare it with "strings").
+		generate_generation
+		BYTES=$(stat --format=%s "$PROGRAM")
+		echo "Scenario '$SCENARIO' (size = $SIZE, $BYTES bytes, best of $RUNS runs)"
+		for compiler in "${COMPILERS[@]}"; do
+			SECONDS_ELAPSED=$(measure "$compiler")
+			OUTPUT_BYTES=$(stat --format=%s "$WORKSPACE/output/benchmark.html")
+			awk -v name="$compiler" -v seconds="$SECONDS_ELAPSED" -v bytes="$OUTPUT_BYTES" \
+				'BEGIN { printf "    %s: %.3f s, %d bytes generated, %.2f MB/s\n", name, seconds, bytes, bytes / seconds / 1e6 }'
+			rm --force --recursive "$WORKSPACE/output"
+		done
+		echo "All done."
+		exit 0
+		;;
+	symbols)
+		# Symbol lookups don't need a program: the microbenchmark builds its own
+		# tables of 1k, 100k and 1M symbols (or SIZE, if it's given).
+		build/SymbolTableBenchmark ${SIZES[@]+"${SIZES[@]}"}
+		exit 0
+		;;
+	*)
+		echo "Unknown scenario: $SCENARIO"
+		exit 1
+		;;
+esac
+
+BYTES=$(stat --format=%s "$PROGRAM")
+echo "Scenario '$SCENARIO' (size = $SIZE, $BYTES bytes, $TOKENS tokens, best of $RUNS runs)"
+for compiler in "${COMPILERS[@]}"; do
+	SECONDS_ELAPSED=$(measure "$compiler")
+	awk -v name="$compiler" -v seconds="$SECONDS_ELAPSED" -v tokens="$TOKENS" -v bytes="$BYTES" \
+		'BEGIN { printf "    %s: %.3f s, %.2f Mtokens/s, %.2f MB/s\n", name, seconds, tokens / seconds / 1e6, bytes / seconds / 1e6 }'
+done
+
+echo "All done."
@@ -14,7 +14,7 @@ echo "Compiler should accept..."
 echo ""
 
 for test in $(ls src/test/c/accept/); do
-	cat "src/test/c/accept/$test" | build/Compiler >/dev/null 2>&1
+	build/Compiler "src/test/c/accept/$test" >/dev/null 2>&1
 	RESULT="$?"
 	if [ "$RESULT" == "0" ]; then
 		echo -e "    $test, ${GREEN}and it does${OFF} (status $RESULT)"
@@ -29,7 +29,7 @@ echo "Compiler should reject..."
 echo ""
 
 for test in $(ls src/test/c/reject/); do
-	cat "src/test/c/reject/$test" | build/Compiler >/dev/null 2>&1
+	build/Compiler "src/test/c/reject/$test" >/dev/null 2>&1
 	RESULT="$?"
 	if [ "$RESULT" != "0" ]; then
 		echo -e "    $test, ${GREEN}and it does${OFF} (status $RESULT)"
@@ -40,5 +40,193 @@ for test in $(ls src/test/c/reject/); do
 done
 echo ""
 
+echo "Compiler should report the same semantic errors with many threads..."
+echo ""
+
+# The semantic errors of a program rejected by many threads must be logged
+# as with a single one: the same, in the same order.
+WORKSPACE="$(mktemp --directory)"
+for test in "24-errors-in-many-slides"; do
+	build/Compiler -s 1 "src/test/c/reject/$test" >/dev/null 2>"$WORKSPACE/sequential.err"
+	build/Compiler -s 8 "src/test/c/reject/$test" >/dev/null 2>"$WORKSPACE/concurrent.err"
+	if [ -s "$WORKSPACE/sequential.err" ] && diff "$WORKSPACE/sequential.err" "$WORKSPACE/concurrent.err" >/dev/null; then
+		echo -e "    $test, errors with 8 workers, ${GREEN}and they match${OFF}"
+	else
+		STATUS=1
+		echo -e "    $test, errors with 8 workers, ${RED}but they differ${OFF}"
+	fi
+done
+rm --force --recursive "$WORKSPACE"
+echo ""
+
+echo "Compiler should compile concurrently..."
+echo ""
+
+# Every accepted program, compiled in a single thread and then in many
+# threads of the same process, must produce the very same presentations.
+WORKSPACE="$(mktemp --directory)"
+build/Compiler -j 1 -o "$WORKSPACE/sequential" src/test/c/accept/* >/dev/null 2>&1
+SEQUENTIAL="$?"
+build/Compiler -j 8 -o "$WORKSPACE/concurrent" src/test/c/accept/* >/dev/null 2>&1
+CONCURRENT="$?"
+if [ "$SEQUENTIAL" == "0" ] && [ "$CONCURRENT" == "0" ] && diff --recursive "$WORKSPACE/sequential" "$WORKSPACE/concurrent" >/dev/null; then
+	echo -e "    $(ls "$WORKSPACE/concurrent" | wc --lines) programs with 8 threads, ${GREEN}and they match${OFF}"
+else
+	STATUS=1
+	echo -e "    8 threads, ${RED}but they differ${OFF} (status $SEQUENTIAL and $CONCURRENT)"
+fi
+rm --force --recursive "$WORKSPACE"
+echo ""
+
+echo "Compiler should parse sections in parallel..."
+echo ""
+
+# Every program, with its sections parsed in their own threads, must be
+# accepted or rejected as when it's parsed as a whole, and the accepted ones
+# must produce the very same presentations.
+WORKSPACE="$(mktemp --directory)"
+build/Compiler -o "$WORKSPACE/whole" src/test/c/accept/* >/dev/null 2>&1
+WHOLE="$?"
+build/Compiler -p -o "$WORKSPACE/sections" src/test/c/accept/* >/dev/null 2>&1
+SECTIONS="$?"
+if [ "$WHOLE" == "0" ] && [ "$SECTIONS" == "0" ] && diff --recursive "$WORKSPACE/whole" "$WORKSPACE/sections" >/dev/null; then
+	echo -e "    $(ls "$WORKSPACE/sections" | wc --lines) programs, ${GREEN}and they match${OFF}"
+else
+	STATUS=1
+	echo -e "    $(ls src/test/c/accept/ | wc --lines) programs, ${RED}but they differ${OFF} (status $WHOLE and $SECTIONS)"
+fi
+for test in $(ls src/test/c/reject/); do
+	build/Compiler -p -o "$WORKSPACE/rejected" "src/test/c/reject/$test" >/dev/null 2>&1
+	RESULT="$?"
+	if [ "$RESULT" != "0" ]; then
+		echo -e "    $test, ${GREEN}and it rejects${OFF} (status $RESULT)"
+	else
+		STATUS=1
+		echo -e "    $test, ${RED}but it accepts${OFF} (status $RESULT)"
+	fi
+done
+rm --force --recursive "$WORKSPACE"
+echo ""
+
+echo "Compiler should lay out slides in parallel..."
+echo ""
+
+# Every accepted program, with its slides laid out by many threads, must
+# produce the very same presentation as with a single one.
+WORKSPACE="$(mktemp --directory)"
+build/Compiler -l 1 -o "$WORKSPACE/sequential" src/test/c/accept/* >/dev/null 2>&1
+SEQUENTIAL="$?"
+build/Compiler -l 8 -o "$WORKSPACE/concurrent" src/test/c/accept/* >/dev/null 2>&1
+CONCURRENT="$?"
+if [ "$SEQUENTIAL" == "0" ] && [ "$CONCURRENT" == "0" ] && diff --recursive "$WORKSPACE/sequential" "$WORKSPACE/concurrent" >/dev/null; then
+	echo -e "    $(ls "$WORKSPACE/concurrent" | wc --lines) programs with 8 workers, ${GREEN}and they match${OFF}"
+else
+	STATUS=1
+	echo -e "    8 workers, ${RED}but they differ${OFF} (status $SEQUENTIAL and $CONCURRENT)"
+fi
+
+# The errors of the layout (cycles and collisions) must be logged in slide
+# order, whatever the number of threads.
+for test in "20-positioning-cycles" "21-positioning-collisions"; do
+	build/Compiler -l 1 -c error -o "$WORKSPACE/sequential" "src/test/c/accept/$test" >/dev/null 2>"$WORKSPACE/sequential.err"
+	build/Compiler -l 8 -c error -o "$WORKSPACE/concurrent" "src/test/c/accept/$test" >/dev/null 2>"$WORKSPACE/concurrent.err"
+	if [ -s "$WORKSPACE/sequential.err" ] && diff "$WORKSPACE/sequential.err" "$WORKSPACE/concurrent.err" >/dev/null; then
+		echo -e "    $test, errors with 8 workers, ${GREEN}and they match${OFF}"
+	else
+		STATUS=1
+		echo -e "    $test, errors with 8 workers, ${RED}but they differ${OFF}"
+	fi
+done
+rm --force --recursive "$WORKSPACE"
+echo ""
+
+echo "Compiler should exit fast..."
+echo ""
+
+# Exiting without releasing anything must not change the presentations.
+WORKSPACE="$(mktemp --directory)"
+build/Compiler -o "$WORKSPACE/released" src/test/c/accept/* >/dev/null 2>&1
+RELEASED="$?"
+build/Compiler -x -o "$WORKSPACE/unreleased" src/test/c/accept/* >/dev/null 2>&1
+UNRELEASED="$?"
+if [ "$RELEASED" == "0" ] && [ "$UNRELEASED" == "0" ] && diff --recursive "$WORKSPACE/released" "$WORKSPACE/unreleased" >/dev/null; then
+	echo -e "    $(ls "$WORKSPACE/unreleased" | wc --lines) programs, ${GREEN}and they match${OFF}"
+else
+	STATUS=1
+	echo -e "    $(ls src/test/c/accept/ | wc --lines) programs, ${RED}but they differ${OFF} (status $RELEASED and $UNRELEASED)"
+fi
+rm --force --recursive "$WORKSPACE"
+echo ""
+
+echo "Compiler should stream the standard input..."
+echo ""
+
+# Every accepted program, read through a pipe, must produce the very same
+# presentation as when it's read from its path.
+WORKSPACE="$(mktemp --directory)"
+for test in $(ls src/test/c/accept/); do
+	build/Compiler -o "$WORKSPACE/path" "src/test/c/accept/$test" >/dev/null 2>&1
+	cat "src/test/c/accept/$test" | build/Compiler -o "$WORKSPACE/stream" >/dev/null 2>&1
+	RESULT="$?"
+	if [ "$RESULT" == "0" ] && diff --recursive "$WORKSPACE/path" "$WORKSPACE/stream" >/dev/null; then
+		echo -e "    $test, ${GREEN}and it does${OFF} (status $RESULT)"
+	else
+		STATUS=1
+		echo -e "    $test, ${RED}but it differs${OFF} (status $RESULT)"
+	fi
+	rm --force --recursive "$WORKSPACE/path" "$WORKSPACE/stream"
+done
+rm --force --recursive "$WORKSPACE"
+echo ""
+
+echo "Compiler should write to the standard output..."
+echo ""
+
+# Every accepted program, generated to the standard output ("-o -"), must
+# produce the very same presentation as in its file (if it has any).
+WORKSPACE="$(mktemp --directory)"
+for test in $(ls src/test/c/accept/); do
+	build/Compiler -o "$WORKSPACE" "src/test/c/accept/$test" >/dev/null 2>&1
+	build/Compiler -o - "src/test/c/accept/$test" > "$WORKSPACE/stdout" 2>/dev/null
+	RESULT="$?"
+	if [ "$RESULT" == "0" ] && cat "$WORKSPACE"/*.html 2>/dev/null | diff "$WORKSPACE/stdout" - >/dev/null; then
+		echo -e "    $test, ${GREEN}and it does${OFF} (status $RESULT)"
+	else
+		STATUS=1
+		echo -e "    $test, ${RED}but it differs${OFF} (status $RESULT)"
+	fi
+	rm --force "$WORKSPACE"/*
+done
+rm --force --recursive "$WORKSPACE"
+echo ""
+
+echo "Compiler should accept long animation sequences..."
+echo ""
+
+# A sequence of a million steps must be accepted, whatever the size of the
+# parser stack.
+WORKSPACE="$(mktemp --directory)"
+{
+	echo "Presentation presentation {"
+	echo "Objects { Slide slide1 { } Image image { } }"
+	echo "Structure { slide1 { add image with \"local/image/path\"; } }"
+	echo "Animations {"
+	echo "slide1 start"
+	yes "then image appear then image disappear" | head --lines=500000
+	echo "end;"
+	echo "}"
+	echo "}"
+} > "$WORKSPACE/program"
+build/Compiler -x -o "$WORKSPACE" "$WORKSPACE/program" >/dev/null 2>&1
+RESULT="$?"
+if [ "$RESULT" == "0" ]; then
+	echo -e "    1000000 steps, ${GREEN}and it does${OFF} (status $RESULT)"
+else
+	STATUS=1
+	echo -e "    1000000 steps, ${RED}but it rejects${OFF} (status $RESULT)"
+fi
+rm --force --recursive "$WORKSPACE"
+echo ""
+
 echo "All done."
 exit $STATUS
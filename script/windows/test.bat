@@ -9,7 +9,7 @@
 
 @set STATUS=0
 @for /f %%f in ('dir /b !BASE_PATH!\src\test\c\accept') do @(
-	@type !BASE_PATH!\src\test\c\accept\%%f | !BASE_PATH!\build\Debug\Compiler.exe >nul 2>&1
+	@!BASE_PATH!\build\Debug\Compiler.exe !BASE_PATH!\src\test\c\accept\%%f >nul 2>&1
 	@set RESULT=!ERRORLEVEL!
 	if !RESULT! equ 0 (
 		@echo     "%%f", [92mand it does[0m ^(status !RESULT!^)
@@ -24,7 +24,7 @@
 @echo:
 
 @for /f %%f in ('dir /b !BASE_PATH!\src\test\c\reject') do @(
-	@type !BASE_PATH!\src\test\c\reject\%%f | !BASE_PATH!\build\Debug\Compiler.exe >nul 2>&1
+	@!BASE_PATH!\build\Debug\Compiler.exe !BASE_PATH!\src\test\c\reject\%%f >nul 2>&1
 	@set RESULT=!ERRORLEVEL!
 	if !RESULT! neq 0 (
 		@echo     "%%f", [92mand it does[0m ^(status !RESULT!^)
@@ -0,0 +1,133 @@
+#include "../../main/c/shared/Arena.h"
+#include "../../main/c/shared/Logger.h"
+#include "../../main/c/shared/StringPool.h"
+#include "../../main/c/shared/SymbolTable.h"
+#include <stdio.h>
+
+/**
+ * Lookup microbenchmark of the symbol table. For each size, it adds that many symbols (interned
+ * identifiers, as the compiler does), and it measures the nanoseconds per lookup of:
+ *
+ *   - a GLib hashtable keyed by the text of the identifiers ("g_str_hash"),
+ *   - a GLib hashtable keyed by the atoms ("g_direct_hash", the previous symbol table),
+ *   - the symbol table, resolving an atom into its ID ("findSymbol"),
+ *   - the symbol table, reaching an item by its ID ("getSymbolById").
+ *
+ * The lookups follow a random order, so that most of them miss the caches at the biggest sizes.
+ *
+ * Usage: SymbolTableBenchmark [size...] (1000 100000 1000000 by default)
+ */
+#define LOOKUPS 10000000
+
+/* PRIVATE FUNCTIONS */
+
+static guint32 _random(guint32 *state) {
+    // Xorshift (Marsaglia, 2003)
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void _report(const char *name, gint64 start, guint64 checksum) {
+    const gint64 elapsed = g_get_monotonic_time() - start;
+    printf("    %-34s %8.2f ns/lookup (checksum %llu)\n", name, 1000.0 * elapsed / LOOKUPS,
+           (unsigned long long)checksum);
+}
+
+static void _benchmark(const int size) {
+    StringPool *stringPool = createStringPool();
+    SymbolTable *symbolTable = initializeSymbolTable();
+    GHashTable *byString = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    GHashTable *byAtom = g_hash_table_new(g_direct_hash, g_direct_equal);
+    char **atoms = malloc(size * sizeof(char *));
+    char **strings = malloc(size * sizeof(char *));
+    char identifier[32];
+    for (int k = 0; k < size; ++k) {
+        snprintf(identifier, sizeof(identifier), "object%d", k);
+        atoms[k] = intern(stringPool, identifier);
+        strings[k] = g_strdup(identifier);
+        addSymbol(symbolTable, atoms[k], OBJ_TEXTBLOCK);
+    }
+    // Once every symbol is added, as adding one can move the items
+    SymbolId *symbols = malloc(size * sizeof(SymbolId));
+    for (int k = 0; k < size; ++k) {
+        symbols[k] = findSymbol(symbolTable, atoms[k]);
+        SymbolTableItem *item = getSymbolById(symbolTable, symbols[k]);
+        g_hash_table_insert(byString, g_strdup(strings[k]), item);
+        g_hash_table_insert(byAtom, atoms[k], item);
+    }
+
+    // The same random order for every table
+    int *order = malloc(LOOKUPS * sizeof(int));
+    guint32 state = 2463534242u;
+    for (int k = 0; k < LOOKUPS; ++k) {
+        order[k] = _random(&state) % size;
+    }
+
+    printf("Symbol table with %d symbols (%d lookups):\n", size, LOOKUPS);
+    guint64 checksum = 0;
+    gint64 start = g_get_monotonic_time();
+    for (int k = 0; k < LOOKUPS; ++k) {
+        SymbolTableItem *item = g_hash_table_lookup(byString, strings[order[k]]);
+        checksum += item->type;
+    }
+    _report("GHashTable (g_str_hash):", start, checksum);
+
+    checksum = 0;
+    start = g_get_monotonic_time();
+    for (int k = 0; k < LOOKUPS; ++k) {
+        SymbolTableItem *item = g_hash_table_lookup(byAtom, atoms[order[k]]);
+        checksum += item->type;
+    }
+    _report("GHashTable (g_direct_hash):", start, checksum);
+
+    checksum = 0;
+    start = g_get_monotonic_time();
+    for (int k = 0; k < LOOKUPS; ++k) {
+        checksum += getSymbolById(symbolTable, findSymbol(symbolTable, atoms[order[k]]))->type;
+    }
+    _report("SymbolTable (findSymbol):", start, checksum);
+
+    checksum = 0;
+    start = g_get_monotonic_time();
+    for (int k = 0; k < LOOKUPS; ++k) {
+        checksum += getSymbolById(symbolTable, symbols[order[k]])->type;
+    }
+    _report("SymbolTable (getSymbolById):", start, checksum);
+
+    for (int k = 0; k < size; ++k) {
+        g_free(strings[k]);
+    }
+    free(symbols);
+    free(order);
+    free(strings);
+    free(atoms);
+    g_hash_table_destroy(byAtom);
+    g_hash_table_destroy(byString);
+    destroySymbolTable(symbolTable);
+    destroyStringPool(stringPool);
+}
+
+/* PUBLIC FUNCTIONS */
+
+const int main(const int count, const char **arguments) {
+    initializeArenaModule();
+    initializeStringPoolModule();
+    initializeSemanticsModule();
+    setGlobalLoggingLevel(ERROR);
+
+    if (count <= 1) {
+        _benchmark(1000);
+        _benchmark(100000);
+        _benchmark(1000000);
+    }
+    for (int k = 1; k < count; ++k) {
+        _benchmark(atoi(arguments[k]));
+    }
+
+    shutdownSemanticsModule();
+    shutdownStringPoolModule();
+    shutdownArenaModule();
+    return 0;
+}
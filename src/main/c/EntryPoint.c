@@ -1,85 +1,247 @@
 #include "backend/code-generation/Generator.h"
 #include "backend/domain-specific/Layout.h"
 #include "frontend/lexical-analysis/FlexActions.h"
+#include "frontend/lexical-analysis/SourceBuffer.h"
+#include "frontend/semantic-analysis/SemanticAnalyzer.h"
 #include "frontend/syntactic-analysis/AbstractSyntaxTree.h"
 #include "frontend/syntactic-analysis/BisonActions.h"
 #include "frontend/syntactic-analysis/SyntacticAnalyzer.h"
 #include "shared/CompilerState.h"
 #include "shared/Environment.h"
+#include "shared/Arena.h"
 #include "shared/Logger.h"
+#include "shared/OutputSink.h"
+#include "shared/PropertySchema.h"
 #include "shared/String.h"
+#include "shared/StringPool.h"
 #include "shared/SymbolTable.h"
 
 /**
- * The main entry-point of the entire application. If you use "strtok" to
- * parse anything inside this project instead of using Flex and Bison, I will
- * find you, and I will kill you (Bryan Mills; "Taken", 2008).
+ * A compilation requested through the command line.
  */
-const int main(const int count, const char **arguments) {
-    LoggingLevel logTo = INFORMATION;
-    Logger *logger = createLogger("EntryPoint");
-    initializeFlexActionsModule();
-    initializeBisonActionsModule();
-    initializeSyntacticAnalyzerModule();
-    initializeAbstractSyntaxTreeModule();
-    initializeSemanticsModule();
-    initializeObjectsModule();
-    initializeGeneratorModule();
+typedef struct {
+    const char *inputPath;           // NULL to read the standard input
+    const char *outputDirectory;     // Where the presentation is generated ("-" for stdout)
+    char *outputName;                // NULL to name the output after the presentation
+    boolean parallelSections;        // Whether to parse each section in its own thread
+    boolean exitFast;                // Whether to leave every resource to the operating system
+    int semanticWorkers;             // Threads that check the slides (0 for as many as it's worth)
+    int layoutWorkers;               // Threads that lay out the slides (0 for one per processor)
+    CollisionPolicy collisionPolicy; // For objects laid out in the same cell
+    CompilationStatus status;
+} Compilation;
 
-    // Logs the arguments of the application.
-    for (int k = 0; k < count; ++k) {
-        logInformation(logger, arguments[k]);
-        if (!strcasecmp(arguments[k], "-v")) {
-            logTo = DEBUGGING;
-        }
-    }
-    setGlobalLoggingLevel(logTo);
+/**
+ * Compiles a single program, from the source to the generated presentation. Every phase works
+ * over the state of this compilation only, so it can run in any thread.
+ */
+static void _compile(Compilation *compilation, Logger *logger) {
+    // The standard input is parsed as it arrives, so there is no source buffer for it
+    SourceBuffer *sourceBuffer =
+        (compilation->inputPath == NULL) ? NULL : openSourceFile(compilation->inputPath);
 
     // Begin compilation process.
     CompilerState compilerState = {.abstractSyntaxtTree = NULL,
+                                   .arena = createArena(),
                                    .symbolTable = initializeSymbolTable(),
+                                   .stringPool = createStringPool(),
                                    .succeed = false,
                                    .slideCounter = 0,
-                                   .slides = NULL};
-    const SyntacticAnalysisStatus syntacticAnalysisStatus = parse(&compilerState);
+                                   .slides = NULL,
+                                   .outputDirectory = compilation->outputDirectory,
+                                   .outputName = compilation->outputName,
+                                   .output = strcmp(compilation->outputDirectory, "-")
+                                                 ? NULL
+                                                 : createStreamSink(stdout)};
+    SyntacticAnalysisStatus syntacticAnalysisStatus = REJECT;
+    if (compilation->inputPath == NULL) {
+        syntacticAnalysisStatus = parseStream(&compilerState, stdin);
+    } else if (sourceBuffer != NULL && compilation->parallelSections) {
+        syntacticAnalysisStatus = parseSections(&compilerState, sourceBuffer);
+    } else if (sourceBuffer != NULL) {
+        syntacticAnalysisStatus = parse(&compilerState, sourceBuffer);
+    }
     CompilationStatus compilationStatus = SUCCEED;
     Program *program = compilerState.abstractSyntaxtTree;
-    if (syntacticAnalysisStatus == ACCEPT) {
+    if (syntacticAnalysisStatus != ACCEPT) {
+        logCritical(logger, "The syntactic-analysis phase rejects the input program.");
+        compilationStatus = FAILED;
+    } else if (!analyzeSemantics(&compilerState, compilation->semanticWorkers)) {
+        logCritical(logger, "The semantic-analysis phase rejects the input program.");
+        compilationStatus = FAILED;
+    } else {
         // ----------------------------------------------------------------------------------------
         // Beginning of the Backend... ------------------------------------------------------------
         logDebugging(logger, "Generating layout maps...");
 
-        compilerState.slides = generateObjects(program);
-        if (compilerState.slides == NULL) {
-            logWarning(logger, "No slides found");
-            compilationStatus = ACCEPT;
-        } else {
-            boolean flag = generate(&compilerState);
-            if (flag) {
-                logCritical(logger, "The code-generation phase rejects the input program");
-            }
+        compilerState.slides = generateObjects(program, compilation->layoutWorkers,
+                                              compilation->collisionPolicy);
+        if (compilerState.slides->errorCount > 0) {
+            logCritical(logger, "The layout phase rejects the input program.");
+            compilationStatus = FAILED;
+        } else if (!generate(&compilerState)) {
+            logCritical(logger, "The code-generation phase rejects the input program");
+            compilationStatus = FAILED;
         }
 
         // ...end of the Backend. -----------------------------------------------------------------
         // ----------------------------------------------------------------------------------------
-    } else {
-        logCritical(logger, "The syntactic-analysis phase rejects the input program.");
+    }
+    // The presentation reaches the standard output at once, even if it ends with an error
+    if (!destroySink(compilerState.output)) {
+        logCritical(logger, "The presentation cannot be written to the standard output.");
         compilationStatus = FAILED;
     }
+    compilation->status = compilationStatus;
+    if (compilation->exitFast) {
+        // The process ends right after the compilations, so nothing gets released
+        return;
+    }
     logDebugging(logger, "Releasing AST resources...");
-    destroyProgram(program);
+    destroyArena(compilerState.arena);
     logDebugging(logger, "Releasing symbol table resources...");
     destroySymbolTable(compilerState.symbolTable);
     logDebugging(logger, "Releasing compiler state resources...");
     destroyObjects(compilerState.slides);
+    logDebugging(logger, "Releasing string pool resources...");
+    destroyStringPool(compilerState.stringPool);
+    logDebugging(logger, "Releasing source resources...");
+    closeSourceBuffer(sourceBuffer);
+}
+
+/**
+ * Worker of the thread pool (see "g_thread_pool_new").
+ */
+static void _compileInPool(gpointer compilation, gpointer logger) {
+    _compile(compilation, logger);
+}
+
+/**
+ * The main entry-point of the entire application. If you use "strtok" to
+ * parse anything inside this project instead of using Flex and Bison, I will
+ * find you, and I will kill you (Bryan Mills; "Taken", 2008).
+ */
+const int main(const int count, const char **arguments) {
+    LoggingLevel logTo = INFORMATION;
+    Logger *logger = createLogger("EntryPoint");
+    initializeSourceBufferModule();
+    initializeFlexActionsModule();
+    initializeBisonActionsModule();
+    initializeSyntacticAnalyzerModule();
+    initializeSemanticAnalyzerModule();
+    initializeAbstractSyntaxTreeModule();
+    initializeSemanticsModule();
+    initializeObjectsModule();
+    initializeGeneratorModule();
+    initializeStringPoolModule();
+    initializeArenaModule();
+    initializeOutputSinkModule();
+    initializePropertySchemaModule();
+
+    // Logs the arguments of the application. Each input program is read from the path given, or
+    // from the standard input if there is none. Many programs can be compiled at once, with up to
+    // "-j" of them at the same time, and the sections of each one can be parsed at the same time
+    // too ("-p"). The slides of each one are checked by "-s" threads, and laid out by "-l" threads
+    // (by default, as many as it's worth, up to one for each processor), and an object laid out over
+    // another one is shifted on to a free cell, or rejected with "-c error". A one-shot run can exit as soon as it's done,
+    // without releasing anything ("-x"). The presentations go to the standard output with "-o -".
+    const char *outputDirectory = "output";
+    int jobs = 1;
+    boolean parallelSections = false;
+    boolean exitFast = false;
+    int semanticWorkers = 0;
+    int layoutWorkers = 0;
+    CollisionPolicy collisionPolicy = COLLISION_SHIFT;
+    GPtrArray *inputPaths = g_ptr_array_new();
+    for (int k = 0; k < count; ++k) {
+        if (!strcasecmp(arguments[k], "-v")) {
+            logTo = DEBUGGING;
+        } else if (!strcmp(arguments[k], "-j") && k + 1 < count) {
+            jobs = atoi(arguments[++k]);
+        } else if (!strcmp(arguments[k], "-s") && k + 1 < count) {
+            semanticWorkers = atoi(arguments[++k]);
+        } else if (!strcmp(arguments[k], "-l") && k + 1 < count) {
+            layoutWorkers = atoi(arguments[++k]);
+        } else if (!strcmp(arguments[k], "-c") && k + 1 < count) {
+            collisionPolicy = strcmp(arguments[++k], "error") ? COLLISION_SHIFT : COLLISION_ERROR;
+        } else if (!strcmp(arguments[k], "-p")) {
+            parallelSections = true;
+        } else if (!strcmp(arguments[k], "-x")) {
+            exitFast = true;
+        } else if (!strcmp(arguments[k], "-o") && k + 1 < count) {
+            outputDirectory = arguments[++k];
+        } else if (0 < k && arguments[k][0] != '-') {
+            g_ptr_array_add(inputPaths, (gpointer)arguments[k]);
+        }
+    }
+    if (!strcmp(outputDirectory, "-") && logTo == INFORMATION) {
+        // The standard output carries the presentations, so only the errors are logged (which go
+        // to the standard error)
+        logTo = ERROR;
+    }
+    setGlobalLoggingLevel(logTo);
+    for (int k = 0; k < count; ++k) {
+        logInformation(logger, arguments[k]);
+    }
+
+    // Begin compilation process. With many programs, each output is named after its input, because
+    // presentations with the same name would overwrite each other.
+    const int compilationCount = (inputPaths->len == 0) ? 1 : inputPaths->len;
+    Compilation *compilations = calloc(compilationCount, sizeof(Compilation));
+    for (int k = 0; k < inputPaths->len; ++k) {
+        compilations[k].inputPath = g_ptr_array_index(inputPaths, k);
+        compilations[k].outputName =
+            (inputPaths->len == 1) ? NULL : g_path_get_basename(compilations[k].inputPath);
+    }
+    for (int k = 0; k < compilationCount; ++k) {
+        compilations[k].outputDirectory = outputDirectory;
+        compilations[k].parallelSections = parallelSections;
+        compilations[k].exitFast = exitFast;
+        compilations[k].semanticWorkers = semanticWorkers;
+        compilations[k].layoutWorkers = layoutWorkers;
+        compilations[k].collisionPolicy = collisionPolicy;
+    }
+    if (jobs <= 1 || compilationCount == 1) {
+        for (int k = 0; k < compilationCount; ++k) {
+            _compile(&compilations[k], logger);
+        }
+    } else {
+        logDebugging(logger, "Compiling %d programs with %d threads...", compilationCount, jobs);
+        GThreadPool *threadPool = g_thread_pool_new(_compileInPool, logger, jobs, TRUE, NULL);
+        for (int k = 0; k < compilationCount; ++k) {
+            g_thread_pool_push(threadPool, &compilations[k], NULL);
+        }
+        g_thread_pool_free(threadPool, FALSE, TRUE);
+    }
+    CompilationStatus compilationStatus = SUCCEED;
+    for (int k = 0; k < compilationCount; ++k) {
+        if (compilations[k].status != SUCCEED) {
+            compilationStatus = FAILED;
+        }
+        g_free(compilations[k].outputName);
+    }
+    if (exitFast) {
+        // Skips the release of every module and every resource (and the handlers of "atexit")
+        fflush(NULL);
+        _Exit(compilationStatus);
+    }
+    free(compilations);
+    g_ptr_array_free(inputPaths, TRUE);
+
     logDebugging(logger, "Releasing modules resources...");
+    shutdownPropertySchemaModule();
+    shutdownOutputSinkModule();
+    shutdownArenaModule();
+    shutdownStringPoolModule();
     shutdownGeneratorModule();
     shutdownObjectsModule();
     shutdownSemanticsModule();
     shutdownAbstractSyntaxTreeModule();
+    shutdownSemanticAnalyzerModule();
     shutdownSyntacticAnalyzerModule();
     shutdownBisonActionsModule();
     shutdownFlexActionsModule();
+    shutdownSourceBufferModule();
     logDebugging(logger, "Compilation is done.");
     destroyLogger(logger);
     return compilationStatus;
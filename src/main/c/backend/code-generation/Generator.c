@@ -2,14 +2,24 @@
 #include <stdlib.h>
 #include <sys/stat.h>
 
-FILE *_outputFile = NULL;
-boolean success = true; // in case of error
 const char _indentationCharacter = ' ';
 const char _indentationSize = 4;
 static Logger *_logger = NULL;
 
 /* MODULE INTERNAL STATE */
 
+// The animations that count for a slide
+typedef struct {
+    AnimationType transition;      // ANIM_NO_ANIM if there is none
+    AnimationDefinition *sequence; // NULL if there is none
+} SlideAnimations;
+
+// A step of a sequence, for the object it animates
+typedef struct {
+    AnimationType type;
+    int order; // Of the step in the whole sequence, from 1
+} ScheduledStep;
+
 void initializeGeneratorModule() { _logger = createLogger("Generator"); }
 
 void shutdownGeneratorModule() {
@@ -19,90 +29,91 @@ void shutdownGeneratorModule() {
 }
 /* helpers */
 static void generatePrologue(CompilerState *compilerState);
-static void generateEpilogue();
+static void generateEpilogue(CompilerState *compilerState);
 static void outputProperties(CompilerState *compilerState);
 
-static void generateSlide(Slide *slide, AnimationDefinition *sequence, SymbolTable *symbolTable);
+static void generateSlide(CompilerState *compilerState, Slide *slide,
+                          AnimationDefinition *sequence);
 static void generateSlides(CompilerState *compilerState);
-static void generateItem(SymbolTableItem *object, char *identifier, char *animations, char *orders);
-static AnimationType findAnimationTransition(Slide *slide, Program *program);
-static AnimationDefinition *findSlideAnimationSequence(Slide *slide, Program *program);
-static char *findObjAnimSteps(char *objIdentifier, AnimationDefinition *animationSeq);
-static char *findObjAnimOrders(char *objIdentifier, AnimationDefinition *animationSeq);
+static void generateItem(CompilerState *compilerState, SymbolTableItem *object, char *identifier,
+                         GArray *schedule);
+static GHashTable *indexSlideAnimations(CompilerState *compilerState);
+static GHashTable *scheduleAnimations(AnimationDefinition *sequence);
+static void generateAnimationAttributes(OutputSink *output, GArray *schedule);
 
 /** PUBLIC FUNCTIONS */
 boolean generate(CompilerState *compilerState) {
     logDebugging(_logger, "Generating final output...");
 
-    int mkdirStatus = mkdir("output", 0755);
-    // write mode to overwrite several calls to the same presentation file
-    Program *ast = (Program *)compilerState->abstractSyntaxtTree;
-    char *title = ast->presentation_identifier;
-    char filepath[256]; // If its too long it will truncate (invalid file but it wont leak memory)
-    snprintf(filepath, sizeof(filepath), "output/%s.html", title);
-    _outputFile = fopen(filepath, "w");
-    if (_outputFile == NULL) {
-        logError(_logger, "Cannot open output file for writing");
-        return false;
+    // Without a sink of the caller (e.g., the standard output), the presentation goes to a file
+    const boolean ownsOutput = (compilerState->output == NULL);
+    if (ownsOutput) {
+        int mkdirStatus = mkdir(compilerState->outputDirectory, 0755);
+        // write mode to overwrite several calls to the same presentation file
+        Program *ast = (Program *)compilerState->abstractSyntaxtTree;
+        const char *title = (compilerState->outputName == NULL) ? ast->presentation_identifier
+                                                                : compilerState->outputName;
+        char filepath[256]; // If its too long it will truncate (invalid file but no leak)
+        snprintf(filepath, sizeof(filepath), "%s/%s.html", compilerState->outputDirectory, title);
+        compilerState->output = createFileSink(filepath);
+        if (compilerState->output == NULL) {
+            logError(_logger, "Cannot open output file for writing");
+            return false;
+        }
     }
     generatePrologue(compilerState);
     // TODO generate css classes for objects
     generateSlides(compilerState);
-    generateEpilogue();
-    fclose(_outputFile);
-    _outputFile = NULL; //  step on pointer
+    generateEpilogue(compilerState);
+    if (ownsOutput) {
+        if (!destroySink(compilerState->output)) {
+            compilerState->succeed = false;
+        }
+        compilerState->output = NULL; //  step on pointer
+    }
     logDebugging(_logger, "Generation is done.");
+    return compilerState->succeed;
 }
 
 /* Private func definitions */
-void generateSlide(Slide *slide, AnimationDefinition *sequence, SymbolTable *symbolTable) {
-    for (int i = slide->maxRow; i >= slide->minRow; i--) {
-        Row *row = g_hash_table_lookup(slide->rows, int_key(i));
-        if (row) {
-            fprintf(_outputFile, "<div class='row'>\n");
-
-            logDebugging(_logger, "Min column: %d, Max column: %d for row %d in slide %s",
-                         row->minCol, row->maxCol, i, slide->identifier);
-
-            for (int j = row->minCol; j <= row->maxCol; j++) {
-                logDebugging(_logger, "Printing column %d for row %d in slide %s", j, i,
-                             slide->identifier);
-                PositionedObject *obj = g_hash_table_lookup(row->columns, int_key(j));
-                if (obj) {
-                    // TODO do all in same function and return a struct
-                    char *animations = findObjAnimSteps(obj->identifier, sequence);
-                    char *orders = findObjAnimOrders(obj->identifier, sequence);
-
-                    generateItem(getSymbol(symbolTable, obj->identifier), obj->identifier,
-                                 animations, orders);
-                    if (animations) {
-                        free(animations);
-                    }
-                    if (orders) {
-                        free(orders);
-                    }
-                } else {
-                    logWarning(_logger, "Column %d not found in row %d of slide %s", j, i,
-                               slide->identifier);
-                }
-            }
-            fprintf(_outputFile, "</div>\n");
+static void generateSlide(CompilerState *compilerState, Slide *slide,
+                          AnimationDefinition *sequence) {
+    OutputSink *output = compilerState->output;
+    Grid *grid = &slide->grid;
+    GHashTable *schedules = scheduleAnimations(sequence);
+    // Only the occupied cells are in the grid, already from the highest row to the lowest
+    for (int k = 0; k < grid->rowCount; k++) {
+        writeLiteral(output, "<div class='row'>\n");
+
+        logDebugging(_logger, "Printing %d objects for row %d in slide %s",
+                     grid->rowOffsets[k + 1] - grid->rowOffsets[k], grid->rows[k],
+                     slide->identifier);
+
+        for (int c = grid->rowOffsets[k]; c < grid->rowOffsets[k + 1]; c++) {
+            PositionedObject *obj = grid->cells[c].object;
+            generateItem(compilerState, getSymbolById(compilerState->symbolTable, obj->symbol),
+                         obj->identifier,
+                         g_hash_table_lookup(schedules, GINT_TO_POINTER(obj->symbol)));
         }
+        writeLiteral(output, "</div>\n");
     }
+    g_hash_table_destroy(schedules);
 }
 
 static void generateSlides(CompilerState *compilerState) {
-    Program *program = compilerState->abstractSyntaxtTree;
     logDebugging(_logger, "Printing each slide in the presentation...");
-    if (_outputFile == NULL) {
+    OutputSink *output = compilerState->output;
+    if (output == NULL) {
         logError(_logger, "Cannot open output file for writing");
         return;
     }
     // iterate through the slides and print them (to file)
+    GHashTable *slideAnimations = indexSlideAnimations(compilerState);
     int i = 0;
     for (Slide *slide = compilerState->slides->head; slide != NULL; slide = slide->next, i++) {
-        AnimationType anim = findAnimationTransition(slide, program);
-        AnimationDefinition *animSeq = findSlideAnimationSequence(slide, program);
+        SlideAnimations *animations = g_hash_table_lookup(slideAnimations, slide->identifier);
+        AnimationType anim = animations ? animations->transition : ANIM_NO_ANIM;
+        AnimationDefinition *animSeq = animations ? animations->sequence : NULL;
         char *animS;
         switch (anim) {
         case ANIM_FADE_INTO:
@@ -117,230 +128,185 @@ static void generateSlides(CompilerState *compilerState) {
         }
         logDebugging(_logger, "Slide %s with animation type %s %d", slide->identifier, animS, anim);
 
+        writeLiteral(output, "<div class='slide ");
+        writeString(output, slide->identifier);
         if (i != 0) {
-            fprintf(_outputFile, "<div class='slide %s' %s data-repeats='1'>\n", slide->identifier,
-                    animS);
-
+            writeLiteral(output, "' ");
         } else {
-            fprintf(_outputFile, "<div class='slide %s active' %s data-repeats='1'>\n",
-                    slide->identifier, animS);
+            writeLiteral(output, " active' ");
         }
-        generateSlide(slide, animSeq, compilerState->symbolTable);
-        fprintf(_outputFile, "</div>\n");
+        writeString(output, animS);
+        writeLiteral(output, " data-repeats='1'>\n");
+        generateSlide(compilerState, slide, animSeq);
+        writeLiteral(output, "</div>\n");
     }
-    if (!success) {
+    g_hash_table_destroy(slideAnimations);
+    if (!compilerState->succeed) {
         logCritical(_logger, "There were errors during the generation process.");
     }
     logDebugging(_logger, "Finished printing each slide.");
 }
 
-static void generatePrologue(CompilerState *CompilerState) {
-    Program *program = CompilerState->abstractSyntaxtTree;
-    fprintf(_outputFile, "<!DOCTYPE html>\n");
-    fprintf(_outputFile, "<html lang='en'>\n");
-    fprintf(_outputFile, "<head>\n");
-    fprintf(_outputFile, "<meta charset='UTF-8'>\n");
-    fprintf(_outputFile,
-            "<meta name='viewport' content='width=device-width, initial-scale=1.0'>\n");
-    fprintf(_outputFile, "<title>%s</title>\n", program->presentation_identifier);
-    fprintf(_outputFile, "<link rel='stylesheet' href='../src/main/web/css/styles.css'>\n");
-    fprintf(_outputFile, "<style>\n");
-    outputProperties(CompilerState);
-    fprintf(_outputFile, "</style>\n");
-    fprintf(_outputFile, "</head>\n");
-    fprintf(_outputFile, "<body>\n");
-    fprintf(_outputFile, "<div class='class-container'>\n");
+static void generatePrologue(CompilerState *compilerState) {
+    OutputSink *output = compilerState->output;
+    Program *program = compilerState->abstractSyntaxtTree;
+    writeLiteral(output, "<!DOCTYPE html>\n"
+                         "<html lang='en'>\n"
+                         "<head>\n"
+                         "<meta charset='UTF-8'>\n"
+                         "<meta name='viewport' content='width=device-width, initial-scale=1.0'>\n"
+                         "<title>");
+    writeString(output, program->presentation_identifier);
+    writeLiteral(output, "</title>\n"
+                         "<link rel='stylesheet' href='../src/main/web/css/styles.css'>\n"
+                         "<style>\n");
+    outputProperties(compilerState);
+    writeLiteral(output, "</style>\n"
+                         "</head>\n"
+                         "<body>\n"
+                         "<div class='class-container'>\n");
 }
 
-static void generateEpilogue() {
-    fprintf(_outputFile, "</div>\n");
-    fprintf(_outputFile, "<div class='slide-number'></div>\n");
-    fprintf(_outputFile, "<script src='../src/main/web/js/core.js'></script>\n");
-    fprintf(_outputFile, "<script src='../src/main/web/js/animation.js'></script>\n");
-    fprintf(_outputFile, "<script src='../src/main/web/js/transition.js'></script>\n");
-    fprintf(_outputFile, "<script src='../src/main/web/js/animation-sequence.js'></script>\n");
-    fprintf(_outputFile, "<script src='../src/main/web/js/slides.js'></script>\n");
-    fprintf(_outputFile, "<script src='../src/main/web/js/controller.js'></script>\n");
-    fprintf(_outputFile, "<script src='../src/main/web/js/ui.js'></script>\n");
-    fprintf(_outputFile, "<script src='../src/main/web/js/main.js'></script>\n");
-    fprintf(_outputFile, "</body>\n");
-    fprintf(_outputFile, "</html>\n");
+static void generateEpilogue(CompilerState *compilerState) {
+    writeLiteral(compilerState->output,
+                 "</div>\n"
+                 "<div class='slide-number'></div>\n"
+                 "<script src='../src/main/web/js/core.js'></script>\n"
+                 "<script src='../src/main/web/js/animation.js'></script>\n"
+                 "<script src='../src/main/web/js/transition.js'></script>\n"
+                 "<script src='../src/main/web/js/animation-sequence.js'></script>\n"
+                 "<script src='../src/main/web/js/slides.js'></script>\n"
+                 "<script src='../src/main/web/js/controller.js'></script>\n"
+                 "<script src='../src/main/web/js/ui.js'></script>\n"
+                 "<script src='../src/main/web/js/main.js'></script>\n"
+                 "</body>\n"
+                 "</html>\n");
 }
 
-// TODO modify ast so that the slide animations are in a different slide (more efficient for many
-// slides)
-static AnimationType findAnimationTransition(Slide *slide, Program *program) {
-    for (AnimationDefinition *animations = program->animation_definitions; animations != NULL;
-         animations = animations->next) {
-        if (animations->kind == ANIM_DEF_PAIR &&
-            (strcasecmp(animations->pair.identifier1, slide->identifier) == 0)) {
-            return animations->pair.type;
+/* The animations are in source order, and the LAST transition and the LAST sequence declared for a
+** slide are the ones that count (the rest are ignored), so a single pass that overwrites the
+** earlier ones indexes them all. The key is the atom of the slide identifier. */
+static GHashTable *indexSlideAnimations(CompilerState *compilerState) {
+    Program *program = compilerState->abstractSyntaxtTree;
+    ArenaArray *definitions = program->animation_definitions;
+    GHashTable *index = g_hash_table_new(g_direct_hash, g_direct_equal);
+    for (guint k = 0; definitions != NULL && k < definitions->len; ++k) {
+        AnimationDefinition *animation = &arenaArrayIndex(definitions, AnimationDefinition, k);
+        char *slide;
+        if (animation->kind == ANIM_DEF_PAIR) {
+            slide = animation->pair.identifier1;
+        } else if (animation->kind == ANIM_DEF_SEQUENCE) {
+            slide = animation->sequence.identifier;
+        } else {
+            continue;
         }
-    }
-    return ANIM_NO_ANIM;
-}
-
-/* This gets the FIRST animation sequence found for that slide.
-** But because the list is constructed backwards, that is the LAST sequence declared for that slide
-** therefore only the last sequence is taken into account (the rest are ignored)
-*/
-static AnimationDefinition *findSlideAnimationSequence(Slide *slide, Program *program) {
-    for (AnimationDefinition *animations = program->animation_definitions; animations != NULL;
-         animations = animations->next) {
-        if (animations->kind == ANIM_DEF_SEQUENCE &&
-            (strcasecmp(animations->sequence.identifier, slide->identifier) == 0)) {
-            logDebugging(_logger, "Animation found for slide %s, it repeats %d times",
-                         slide->identifier, animations->sequence.repeat_count);
-            return animations;
+        SlideAnimations *animations = g_hash_table_lookup(index, slide);
+        if (animations == NULL) {
+            animations = allocateInArena(compilerState->arena, sizeof(SlideAnimations));
+            animations->transition = ANIM_NO_ANIM;
+            g_hash_table_insert(index, slide, animations);
+        }
+        if (animation->kind == ANIM_DEF_PAIR) {
+            animations->transition = animation->pair.type;
+        } else {
+            logDebugging(_logger, "Animation found for slide %s, it repeats %d times", slide,
+                         animation->sequence.repeat_count);
+            animations->sequence = animation;
         }
     }
-    return NULL;
+    return index;
 }
 
-// Given a sequence, for each step where the object appears as identifier, concat to a string the
-// animation type (case appear, case dissapear and case rotate)
-// builds dinamically -> must free after
-
-static char *findObjAnimSteps(char *objIdentifier, AnimationDefinition *animationSeq) {
-    if (!animationSeq || animationSeq->kind != ANIM_DEF_SEQUENCE || !objIdentifier) {
-        return NULL;
+// Groups the steps of a sequence by the object they animate, in a single pass: each object gets
+// its steps in order, as a GArray of ScheduledStep (the key is the symbol of the object)
+static GHashTable *scheduleAnimations(AnimationDefinition *sequence) {
+    GHashTable *schedules =
+        g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, (GDestroyNotify)g_array_unref);
+    if (!sequence || sequence->kind != ANIM_DEF_SEQUENCE) {
+        return schedules;
     }
-    char *result = malloc(1);
-    if (!result) {
-        logError(_logger, "Memory allocation failed");
-        success = FALSE;
-        return NULL;
-    }
-    result[0] = '\0';
-    int currentSize = 1;
-    AnimationStep *step = animationSeq->sequence.steps;
-    int first = 1;
-
-    while (step != NULL) {
-        if (strcasecmp(step->identifier, objIdentifier) == 0) {
-            const char *animType = NULL;
-            int animTypeLen = 0;
-            switch (step->type) {
-            case ANIM_APPEAR:
-                animType = "appear";
-                animTypeLen = 6;
-                break;
-            case ANIM_DISAPPEAR:
-                animType = "disappear";
-                animTypeLen = 9;
-                break;
-            case ANIM_ROTATE:
-                animType = "rotate";
-                animTypeLen = 6;
-                break;
-            default:
-                break;
-            }
-
-            if (animType) {
-                int spaceNeeded = animTypeLen + (first ? 0 : 1);
-                int newSize = currentSize + spaceNeeded;
-
-                char *newResult = realloc(result, newSize);
-                if (!newResult) {
-                    logError(_logger, "Memory reallocation failed ");
-                    free(result);
-                    return NULL;
-                }
-                result = newResult;
-                if (!first) {
-                    strcat(result, " ");
-                }
-                strcat(result, animType);
-                currentSize = newSize;
-                first = 0;
-            }
+    ArenaArray *steps = sequence->sequence.steps;
+    for (guint k = 0; k < steps->len; ++k) {
+        AnimationStep *step = &arenaArrayIndex(steps, AnimationStep, k);
+        if (step->symbol == NO_SYMBOL)
+            continue;
+        GArray *schedule = g_hash_table_lookup(schedules, GINT_TO_POINTER(step->symbol));
+        if (!schedule) {
+            schedule = g_array_new(FALSE, FALSE, sizeof(ScheduledStep));
+            g_hash_table_insert(schedules, GINT_TO_POINTER(step->symbol), schedule);
         }
-        step = step->next;
-    }
-    if (currentSize == 1) {
-        free(result);
-        return NULL;
+        ScheduledStep scheduled = {.type = step->type, .order = k + 1};
+        g_array_append_val(schedule, scheduled);
     }
-    return result;
+    return schedules;
 }
 
-static char *findObjAnimOrders(char *objIdentifier, AnimationDefinition *animationSeq) {
-    if (!animationSeq || animationSeq->kind != ANIM_DEF_SEQUENCE || !objIdentifier) {
-        return NULL;
-    }
-    char *result = malloc(1);
-    if (!result) {
-        logError(_logger, "Memory allocation failed");
-        success = FAILED;
-        return NULL;
-    }
-    result[0] = '\0';
-    int currentSize = 1;
-    AnimationStep *step = animationSeq->sequence.steps;
-    int first = 1;
-    int stepNumber = 1;
-
-    while (step != NULL) {
-        if (strcasecmp(step->identifier, objIdentifier) == 0) {
-            char stepStr[16]; // up to 999999 is enough...
-            snprintf(stepStr, sizeof(stepStr), "%d", stepNumber);
-            int stepStrLen = strlen(stepStr);
-
-            int spaceNeeded = stepStrLen + (first ? 0 : 2); // +2 for comma and space if not first
-            int newSize = currentSize + spaceNeeded;
-
-            char *newResult = realloc(result, newSize);
-            if (!newResult) {
-                logError(_logger, "Memory reallocation failed");
-                free(result);
-                success = FALSE;
-                return NULL;
-            }
-            result = newResult;
-            if (!first) {
-                strcat(result, ", ");
-            }
-            strcat(result, stepStr);
-            currentSize = newSize;
-            first = 0;
+// Writes the animations of an object (case appear, case dissapear and case rotate) and the order
+// of each one in the sequence, as attributes of its element
+static void generateAnimationAttributes(OutputSink *output, GArray *schedule) {
+    writeLiteral(output, " data-animation='");
+    for (guint k = 0; k < schedule->len; ++k) {
+        ScheduledStep *step = &g_array_index(schedule, ScheduledStep, k);
+        if (k != 0) {
+            writeCharacter(output, ' ');
+        }
+        switch (step->type) {
+        case ANIM_APPEAR:
+            writeLiteral(output, "appear");
+            break;
+        case ANIM_DISAPPEAR:
+            writeLiteral(output, "disappear");
+            break;
+        case ANIM_ROTATE:
+            writeLiteral(output, "rotate");
+            break;
+        default:
+            break;
         }
-        step = step->next;
-        stepNumber++;
     }
-    if (currentSize == 1) {
-        free(result);
-        return NULL;
+    writeLiteral(output, "' data-anim-order='");
+    for (guint k = 0; k < schedule->len; ++k) {
+        if (k != 0) {
+            writeLiteral(output, ", ");
+        }
+        writeInteger(output, g_array_index(schedule, ScheduledStep, k).order);
     }
-    return result;
+    writeCharacter(output, '\'');
 }
 
 /* In many cases we use switches because if/else does not scale and its quite possible other object
  * types will be included*/
-static void generateItem(SymbolTableItem *object, char *identifier, char *animations,
-                         char *orders) {
+static void generateItem(CompilerState *compilerState, SymbolTableItem *object, char *identifier,
+                         GArray *schedule) {
+    OutputSink *output = compilerState->output;
     switch (object->type) {
     case OBJ_IMAGE:
-        if (animations && orders) {
-            fprintf(
-                _outputFile,
-                "<img src='%s' class='slide-image %s' data-animation='%s' data-anim-order='%s'>\n",
-                object->string, identifier, animations, orders);
-        } else {
-            fprintf(_outputFile, "<img src='%s' class='slide-image %s'>\n", object->string,
-                    identifier);
+        // The path is an attribute value, so a quote in it must not end the attribute
+        writeLiteral(output, "<img src='");
+        if (object->string.text != NULL) {
+            writeEscaped(output, object->string.text, object->string.length);
+        }
+        writeLiteral(output, "' class='slide-image ");
+        writeString(output, identifier);
+        writeCharacter(output, '\'');
+        if (schedule) {
+            generateAnimationAttributes(output, schedule);
         }
+        writeLiteral(output, ">\n");
         break;
 
     case OBJ_TEXTBLOCK:
-        if (animations && orders) {
-            fprintf(_outputFile,
-                    "<div class='%s' data-animation='%s' data-anim-order='%s'>%s</div>\n", identifier,
-                    animations, orders, (object->string == NULL) ? "" : object->string);
-        } else {
-            fprintf(_outputFile, "<div class='%s'>%s</div>\n", identifier,
-                    (object->string == NULL) ? "" : object->string);
+        writeLiteral(output, "<div class='");
+        writeString(output, identifier);
+        writeCharacter(output, '\'');
+        if (schedule) {
+            generateAnimationAttributes(output, schedule);
         }
+        writeCharacter(output, '>');
+        if (object->string.text != NULL) {
+            writeToSink(output, object->string.text, object->string.length);
+        }
+        writeLiteral(output, "</div>\n");
         break;
     default:
         break;
@@ -348,58 +314,30 @@ static void generateItem(SymbolTableItem *object, char *identifier, char *animat
 }
 
 static void outputProperties(CompilerState *compilerState) {
-    SymbolTable *SymbolTable = compilerState->symbolTable;
-
-    if (SymbolTable == NULL || SymbolTable->table == NULL) {
-        return;
-    }
-    // iterate through all symbols
-    GHashTableIter iter;
-    gpointer key, value;
-
-    g_hash_table_iter_init(&iter, SymbolTable->table);
+    OutputSink *output = compilerState->output;
+    Program *program = compilerState->abstractSyntaxtTree;
 
-    while (g_hash_table_iter_next(&iter, &key, &value)) {
-        char *identifier = (char *)key;
-        SymbolTableItem *item = (SymbolTableItem *)value;
+    // iterate through all object definitions (the symbol table is keyed by address, so its order
+    // would change from run to run)
+    ArenaArray *objects = program->object_definitions;
+    for (guint k = 0; k < objects->len; ++k) {
+        ObjectDefinition *object = &arenaArrayIndex(objects, ObjectDefinition, k);
+        char *identifier = object->identifier;
 
         // only output for those with properties defined
-        if (item == NULL || item->properties == NULL) {
-            logDebugging(_logger, "Skipping item %s - item is NULL or has no properties",
-                         identifier);
+        if (object->css_properties->len == 0) {
+            logDebugging(_logger, "Skipping item %s - it has no properties", identifier);
             continue;
         }
 
-        char *cssProperties = NULL;
         logDebugging(
             _logger,
             "Processing item %s with type %d (OBJ_SLIDE=%d, OBJ_TEXTBLOCK=%d, OBJ_IMAGE=%d)",
-            identifier, item->type, OBJ_SLIDE, OBJ_TEXTBLOCK, OBJ_IMAGE);
-
-        switch (item->type) {
-        case OBJ_IMAGE:
-            logDebugging(_logger, "Calling parseImageProperties for %s", identifier);
-            cssProperties = parseImageProperties(item->properties);
-            break;
-        case OBJ_TEXTBLOCK:
-            logDebugging(_logger, "Calling parseTextblockProperties for %s", identifier);
-            cssProperties = parseTextblockProperties(item->properties);
-            break;
-        case OBJ_SLIDE:
-            logDebugging(_logger, "Calling parseSlideProperties for %s", identifier);
-            cssProperties = parseSlideProperties(item->properties);
-            break;
-        default:
-            logDebugging(_logger, "Unknown object type %d for %s", item->type, identifier);
-            continue;
-        }
+            identifier, object->type, OBJ_SLIDE, OBJ_TEXTBLOCK, OBJ_IMAGE);
 
         // dont output if there were no valid props
-        if (cssProperties != NULL) {
-            if (strlen(cssProperties) > 0) {
-                fprintf(_outputFile, ".%s {\n%s }\n", identifier, cssProperties);
-            }
-            free(cssProperties);
+        if (!writeCssRule(output, identifier, object->type, object->css_properties)) {
+            logDebugging(_logger, "Skipping item %s - none of its properties is valid", identifier);
         }
     }
 }
\ No newline at end of file
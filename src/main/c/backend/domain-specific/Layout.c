@@ -1,11 +1,16 @@
 #include "Layout.h"
+#include "../../shared/Arena.h"
 #include "../../shared/CompilerState.h"
 #include "../../shared/Logger.h"
+#include "../../shared/Parallel.h"
 #include "../../shared/Type.h"
 #include <glib.h>
 
 /* MODULE INTERNAL STATE */
 
+// With fewer slides than this for each worker, a thread costs more than it saves
+#define MINIMUM_SLIDES_PER_WORKER 256
+
 static Logger *_logger = NULL;
 
 void initializeObjectsModule() { _logger = createLogger("Objects"); }
@@ -24,17 +29,61 @@ static gboolean int_equal(gconstpointer v1, gconstpointer v2) { return v1 == v2;
 // Convert int to pointer for hash table keys
 gpointer int_key(int value) { return GINT_TO_POINTER(value); }
 
-static void destroy_positioned_object(gpointer data) {
-    PositionedObject *obj = data;
-    if (obj) {
-        free(obj->identifier);
-        free(obj);
+// A warning or an error of the layout of a slide. The slides are laid out in many threads, so the
+// diagnostics wait in their slide, to be logged in slide order once every worker is done.
+typedef struct {
+    LoggingLevel level;
+    char *message;
+} LayoutDiagnostic;
+
+static void destroy_diagnostic(gpointer data) {
+    LayoutDiagnostic *diagnostic = data;
+    g_free(diagnostic->message);
+    free(diagnostic);
+}
+
+static void report(Slide *slide, LoggingLevel level, const char *format, ...) {
+    if (!shouldLog(_logger, level)) {
+        return;
     }
+    if (slide->diagnostics == NULL) {
+        slide->diagnostics = g_ptr_array_new_with_free_func(destroy_diagnostic);
+    }
+    LayoutDiagnostic *diagnostic = malloc(sizeof(LayoutDiagnostic));
+    va_list arguments;
+    va_start(arguments, format);
+    diagnostic->level = level;
+    diagnostic->message = g_strdup_vprintf(format, arguments);
+    va_end(arguments);
+    g_ptr_array_add(slide->diagnostics, diagnostic);
 }
 
-Row *create_row() {
-    Row *row = calloc(1, sizeof(Row));
-    row->columns = g_hash_table_new_full(int_hash, int_equal, NULL, NULL);
+// Logs the diagnostics of a slide, in the order they were reported, and releases them
+static void log_diagnostics(Slide *slide) {
+    if (slide->diagnostics == NULL) {
+        return;
+    }
+    for (guint k = 0; k < slide->diagnostics->len; ++k) {
+        LayoutDiagnostic *diagnostic = g_ptr_array_index(slide->diagnostics, k);
+        switch (diagnostic->level) {
+        case CRITICAL:
+            logCritical(_logger, "%s", diagnostic->message);
+            break;
+        case ERROR:
+            logError(_logger, "%s", diagnostic->message);
+            break;
+        default:
+            logWarning(_logger, "%s", diagnostic->message);
+            break;
+        }
+    }
+    g_ptr_array_free(slide->diagnostics, TRUE);
+    slide->diagnostics = NULL;
+}
+
+// Rows live in the arena of their slide, so only a table of columns, if any, gets released
+Row *create_row(Arena *arena) {
+    Row *row = allocateInArena(arena, sizeof(Row));
     row->minCol = INT_MAX;
     row->maxCol = INT_MIN;
     return row;
@@ -42,16 +91,82 @@ Row *create_row() {
 
 static void destroy_row(gpointer data) {
     Row *row = data;
-    g_hash_table_destroy(row->columns);
-    free(row);
+    if (row->columns) {
+        g_hash_table_destroy(row->columns);
+    }
 }
 
-Slide *create_slide() {
+/* The columns of a row: in the row itself while they fit, and in a table of their own after that */
+
+static PositionedObject *row_lookup(Row *row, int col) {
+    if (row->columns) {
+        return g_hash_table_lookup(row->columns, int_key(col));
+    }
+    for (int k = 0; k < row->count; ++k) {
+        if (row->cells[k].col == col)
+            return row->cells[k].object;
+    }
+    return NULL;
+}
+
+static void row_insert(Row *row, int col, PositionedObject *obj) {
+    if (!row->columns) {
+        for (int k = 0; k < row->count; ++k) {
+            if (row->cells[k].col == col) {
+                row->cells[k].object = obj;
+                return;
+            }
+        }
+        if (row->count < ROW_INLINE_CELLS) {
+            row->cells[row->count].col = col;
+            row->cells[row->count].object = obj;
+            row->count++;
+            return;
+        }
+        row->columns = g_hash_table_new(int_hash, int_equal);
+        for (int k = 0; k < row->count; ++k) {
+            g_hash_table_insert(row->columns, int_key(row->cells[k].col), row->cells[k].object);
+        }
+    }
+    g_hash_table_insert(row->columns, int_key(col), obj);
+    row->count = g_hash_table_size(row->columns);
+}
+
+static void row_steal(Row *row, int col) {
+    if (row->columns) {
+        g_hash_table_steal(row->columns, int_key(col));
+        row->count = g_hash_table_size(row->columns);
+        return;
+    }
+    for (int k = 0; k < row->count; ++k) {
+        if (row->cells[k].col == col) {
+            row->cells[k] = row->cells[--row->count];
+            return;
+        }
+    }
+}
+
+// Copies the cells of a row, in no particular order
+static void row_collect(Row *row, GridCell *cells) {
+    if (!row->columns) {
+        memcpy(cells, row->cells, row->count * sizeof(GridCell));
+        return;
+    }
+    GHashTableIter iter;
+    gpointer key, value;
+    g_hash_table_iter_init(&iter, row->columns);
+    for (int k = 0; g_hash_table_iter_next(&iter, &key, &value); ++k) {
+        cells[k].col = GPOINTER_TO_INT(key);
+        cells[k].object = value;
+    }
+}
+
+Slide *create_slide(Arena *arena) {
     logDebugging(_logger, "Creating a new slide");
-    Slide *slide = calloc(1, sizeof(Slide));
+    Slide *slide = allocateInArena(arena, sizeof(Slide));
+    slide->arena = arena;
     slide->rows = g_hash_table_new_full(int_hash, int_equal, NULL, (GDestroyNotify)destroy_row);
-    slide->symbolToObject =
-        g_hash_table_new_full(g_str_hash, g_str_equal, free, destroy_positioned_object);
+    slide->symbolToObject = g_hash_table_new(g_direct_hash, g_direct_equal);
     slide->minRow = INT_MAX;
     slide->maxRow = INT_MIN;
     slide->minCol = INT_MAX;
@@ -59,18 +174,19 @@ Slide *create_slide() {
     return slide;
 }
 
-void update_bounds(Slide *slide) {
+// Rescans the rows of a slide, which is only needed when objects are lifted from the grid
+static void update_bounds(Slide *slide) {
     slide->minRow = INT_MAX;
     slide->maxRow = INT_MIN;
     slide->minCol = INT_MAX;
     slide->maxCol = INT_MIN;
 
-    GList *rowKeys = g_hash_table_get_keys(slide->rows);
-    for (GList *rk = rowKeys; rk != NULL; rk = rk->next) {
-        int row = GPOINTER_TO_INT(rk->data);
-        Row *rowPtr = g_hash_table_lookup(slide->rows, rk->data);
-        if (!rowPtr)
-            continue;
+    GHashTableIter iter;
+    gpointer key, value;
+    g_hash_table_iter_init(&iter, slide->rows);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+        int row = GPOINTER_TO_INT(key);
+        Row *rowPtr = value;
 
         if (row < slide->minRow)
             slide->minRow = row;
@@ -81,76 +197,105 @@ void update_bounds(Slide *slide) {
         if (rowPtr->maxCol > slide->maxCol)
             slide->maxCol = rowPtr->maxCol;
     }
-    g_list_free(rowKeys);
 }
 
-void remove_object(Slide *slide, PositionedObject *obj) {
-    Row *row = g_hash_table_lookup(slide->rows, int_key(obj->row));
-    if (!row)
-        return;
-    g_hash_table_steal(row->columns, int_key(obj->col));
-}
+// Rescans the columns of a row, which is only needed when objects are lifted from the grid
+static void update_row_bounds(Row *row) {
+    row->minCol = INT_MAX;
+    row->maxCol = INT_MIN;
 
-void move_object(Slide *slide, PositionedObject *obj, int newRow, int newCol) {
-    // Check for a collision at the destination.
-    Row *destRowPtr = g_hash_table_lookup(slide->rows, int_key(newRow));
-    if (destRowPtr) {
-        PositionedObject *occupant = g_hash_table_lookup(destRowPtr->columns, int_key(newCol));
-        // If the spot is occupied by a *different* object, cancel the move.
-        if (occupant && occupant != obj) {
-            logWarning(_logger,
-                       "Cannot move object '%s' to (%d, %d). Position is already occupied by "
-                       "'%s'. The move is cancelled.",
-                       obj->identifier, newRow, newCol, occupant->identifier);
-            return;
-        }
+    GridCell *cells = row->columns ? g_new(GridCell, row->count) : row->cells;
+    if (row->columns) {
+        row_collect(row, cells);
     }
-
-    remove_object(slide, obj);
-    obj->row = newRow;
-    obj->col = newCol;
-
-    if (!destRowPtr) {
-        destRowPtr = create_row();
-        g_hash_table_insert(slide->rows, int_key(newRow), destRowPtr);
+    for (int k = 0; k < row->count; ++k) {
+        if (cells[k].col < row->minCol)
+            row->minCol = cells[k].col;
+        if (cells[k].col > row->maxCol)
+            row->maxCol = cells[k].col;
+    }
+    if (row->columns) {
+        g_free(cells);
     }
-    g_hash_table_insert(destRowPtr->columns, int_key(newCol), obj);
+}
 
-    if (newCol < destRowPtr->minCol)
-        destRowPtr->minCol = newCol;
-    if (newCol > destRowPtr->maxCol)
-        destRowPtr->maxCol = newCol;
+// Puts an object in its cell, widening the bounds of its row and its slide (in constant time)
+static void place_object(Slide *slide, PositionedObject *obj) {
+    Row *rowPtr = g_hash_table_lookup(slide->rows, int_key(obj->row));
+    if (!rowPtr) {
+        rowPtr = create_row(slide->arena);
+        g_hash_table_insert(slide->rows, int_key(obj->row), rowPtr);
+    }
+    row_insert(rowPtr, obj->col, obj);
+
+    if (obj->col < rowPtr->minCol)
+        rowPtr->minCol = obj->col;
+    if (obj->col > rowPtr->maxCol)
+        rowPtr->maxCol = obj->col;
+
+    if (obj->row < slide->minRow)
+        slide->minRow = obj->row;
+    if (obj->row > slide->maxRow)
+        slide->maxRow = obj->row;
+    if (obj->col < slide->minCol)
+        slide->minCol = obj->col;
+    if (obj->col > slide->maxCol)
+        slide->maxCol = obj->col;
+}
 
-    update_bounds(slide);
+// The object in a cell, or NULL if it's free (a probe for the row and one for the column)
+static PositionedObject *cell_occupant(Slide *slide, int row, int col) {
+    Row *rowPtr = g_hash_table_lookup(slide->rows, int_key(row));
+    return rowPtr ? row_lookup(rowPtr, col) : NULL;
 }
 
-void insert_object(Slide *slide, const char *identifier, int row, int col) {
-    PositionedObject *obj = calloc(1, sizeof(PositionedObject));
-    obj->identifier = strdup(identifier);
+// Places an object at a cell, unless another object is already there: then, it moves on by the
+// step to the first free cell (COLLISION_SHIFT), or it's left out of the grid (COLLISION_ERROR).
+// Returns whether the object got placed.
+static gboolean place_object_at(Slide *slide, PositionedObject *obj, int row, int col, int rowStep,
+                                int colStep) {
+    PositionedObject *occupant = cell_occupant(slide, row, col);
+    if (occupant && occupant != obj) {
+        if (slide->collisionPolicy == COLLISION_ERROR || (rowStep == 0 && colStep == 0)) {
+            report(slide, ERROR,
+                   "Cannot place object '%s' at (%d, %d) in slide '%s'. Position is already "
+                   "occupied by '%s'.",
+                   obj->identifier, row, col, slide->identifier, occupant->identifier);
+            slide->collisionErrors++;
+            return FALSE;
+        }
+        PositionedObject *blocker = occupant;
+        do {
+            row += rowStep;
+            col += colStep;
+            occupant = cell_occupant(slide, row, col);
+        } while (occupant && occupant != obj);
+        report(slide, WARNING, "Object '%s' collides with '%s' in slide '%s'. Shifted to (%d, %d).",
+               obj->identifier, blocker->identifier, slide->identifier, row, col);
+    }
     obj->row = row;
     obj->col = col;
+    place_object(slide, obj);
+    return TRUE;
+}
 
-    Row *rowPtr = g_hash_table_lookup(slide->rows, int_key(row));
-    if (!rowPtr) {
-        rowPtr = create_row();
-        g_hash_table_insert(slide->rows, int_key(row), rowPtr);
-    }
-    g_hash_table_insert(rowPtr->columns, int_key(col), obj);
-
-    if (col < rowPtr->minCol)
-        rowPtr->minCol = col;
-    if (col > rowPtr->maxCol)
-        rowPtr->maxCol = col;
-
-    g_hash_table_insert(slide->symbolToObject, strdup(identifier), obj);
-    update_bounds(slide);
+void insert_object(Slide *slide, char *identifier, SymbolId symbol, int row, int col) {
+    PositionedObject *obj = allocateInArena(slide->arena, sizeof(PositionedObject));
+    obj->identifier = identifier;
+    obj->symbol = symbol;
+    obj->row = row;
+    obj->col = col;
+    place_object(slide, obj);
+    g_hash_table_insert(slide->symbolToObject, GINT_TO_POINTER(symbol), obj);
 }
 
-void populate_slide_with_content(Slide *slide, SlideContent *contentList) {
-    int currentRow = 0;
-    for (SlideContent *content = contentList; content != NULL; content = content->next) {
+// Rows are printed from the highest to the lowest, so the first object added gets the highest row
+void populate_slide_with_content(Slide *slide, ArenaArray *contentList) {
+    int currentRow = contentList->len;
+    for (guint k = 0; k < contentList->len; ++k) {
+        SlideContent *content = &arenaArrayIndex(contentList, SlideContent, k);
         if (content->type == SLIDE_CONTENT_ADD && content->add.identifier != NULL) {
-            insert_object(slide, content->add.identifier, currentRow++, 0);
+            insert_object(slide, content->add.identifier, content->add.symbol, --currentRow, 0);
         }
     }
 }
@@ -162,33 +307,38 @@ typedef struct {
     PositionedObject *parent;
     Position pos_type;
     VisitState visit_state;
-    int final_row;
-    int final_col;
     gboolean is_resolved;
 } DependencyInfo;
 
-static gboolean resolve_object_position(PositionedObject *obj, GHashTable *dep_graph);
+static gboolean resolve_positions(Slide *slide, GHashTable *dep_graph, GPtrArray *children,
+                                  GPtrArray *order);
+static void lift_objects(Slide *slide, GPtrArray *objects);
+static void apply_position_offset(Position pos_type, int *row, int *col);
 
-void apply_relative_positions(Slide *slide, SlideContent *positions) {
+void apply_relative_positions(Slide *slide, ArenaArray *positions) {
 
     GHashTable *dep_graph = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, free);
+    // The children in source order, so that the cycles are always reported in the same order
+    GPtrArray *children = g_ptr_array_new();
 
-    for (SlideContent *pos = positions; pos != NULL; pos = pos->next) {
+    // The first rule of each object (in source order) is the one that counts
+    for (guint k = 0; k < positions->len; ++k) {
+        SlideContent *pos = &arenaArrayIndex(positions, SlideContent, k);
         if (pos->type != SLIDE_CONTENT_DOUBLE_POS)
             continue;
 
-        PositionedObject *child =
-            g_hash_table_lookup(slide->symbolToObject, pos->position_items.child);
-        PositionedObject *parent =
-            g_hash_table_lookup(slide->symbolToObject, pos->position_items.parent);
+        PositionedObject *child = g_hash_table_lookup(
+            slide->symbolToObject, GINT_TO_POINTER(pos->position_items.childSymbol));
+        PositionedObject *parent = g_hash_table_lookup(
+            slide->symbolToObject, GINT_TO_POINTER(pos->position_items.parentSymbol));
 
         if (!parent || !child)
             continue;
 
         if (g_hash_table_contains(dep_graph, child)) {
-            logWarning(_logger,
-                       "Object '%s' already has a relative position defined. Ignoring new rule.",
-                       child->identifier);
+            report(slide, WARNING,
+                   "Object '%s' already has a relative position defined. Ignoring new rule.",
+                   child->identifier);
             continue;
         }
 
@@ -198,211 +348,321 @@ void apply_relative_positions(Slide *slide, SlideContent *positions) {
         info->visit_state = NODE_UNVISITED;
         info->is_resolved = FALSE;
         g_hash_table_insert(dep_graph, child, info);
+        g_ptr_array_add(children, child);
     }
 
-    // If we detect
-    GList *children = g_hash_table_get_keys(dep_graph);
-    gboolean cycle_detected = FALSE;
-    for (GList *l = children; l != NULL; l = l->next) {
-        PositionedObject *child = l->data;
-        if (!resolve_object_position(child, dep_graph)) {
-            logCritical(_logger,
-                        "A cycle was detected in the positioning rules for slide '%s'. Aborting "
-                        "layout process for this slide.",
-                        slide->identifier);
-            cycle_detected = TRUE;
-            break;
-        }
-    }
-    g_list_free(children);
+    // The children, each one after its parent
+    GPtrArray *order = g_ptr_array_new();
+    gboolean acyclic = resolve_positions(slide, dep_graph, children, order);
+    g_ptr_array_free(children, TRUE);
 
-    if (cycle_detected) {
-        // cleanup
+    if (!acyclic) {
+        report(slide, CRITICAL,
+               "There are cycles in the positioning rules for slide '%s'. Aborting layout "
+               "process for this slide.",
+               slide->identifier);
+    }
+    if (!acyclic || order->len == 0) {
+        // cleanup (without rules, every object is already where it belongs)
+        g_ptr_array_free(order, TRUE);
         g_hash_table_destroy(dep_graph);
         return;
     }
-    GHashTableIter iter;
-    gpointer key, value;
-    g_hash_table_iter_init(&iter, dep_graph);
-    while (g_hash_table_iter_next(&iter, &key, &value)) {
-        PositionedObject *obj = key;
-        DependencyInfo *info = value;
-        obj->row = info->final_row;
-        obj->col = info->final_col;
-    }
-
-    // grid rebuilding
-    GList *all_rows = g_hash_table_get_keys(slide->rows);
-    for (GList *l = all_rows; l != NULL; l = l->next) {
-        Row *row = g_hash_table_lookup(slide->rows, l->data);
-        g_hash_table_remove_all(row->columns);
-    }
-    g_hash_table_remove_all(slide->rows);
-    g_list_free(all_rows);
-
-    GList *all_objects = g_hash_table_get_values(slide->symbolToObject);
-    for (GList *l = all_objects; l != NULL; l = l->next) {
-        PositionedObject *obj = l->data;
-        Row *rowPtr = g_hash_table_lookup(slide->rows, int_key(obj->row));
-        if (!rowPtr) {
-            rowPtr = create_row();
-            g_hash_table_insert(slide->rows, int_key(obj->row), rowPtr);
-        }
-        g_hash_table_insert(rowPtr->columns, int_key(obj->col), obj);
-        if (obj->col < rowPtr->minCol)
-            rowPtr->minCol = obj->col;
-        if (obj->col > rowPtr->maxCol)
-            rowPtr->maxCol = obj->col;
-    }
-    g_list_free(all_objects);
 
-    update_bounds(slide);
+    // The children are lifted from the grid, and placed again next to their parents (which are
+    // already where they belong), so that every collision is found as it happens
+    lift_objects(slide, order);
+    for (guint k = 0; k < order->len; ++k) {
+        PositionedObject *child = g_ptr_array_index(order, k);
+        DependencyInfo *info = g_hash_table_lookup(dep_graph, child);
+        int rowStep = 0;
+        int colStep = 0;
+        apply_position_offset(info->pos_type, &rowStep, &colStep);
+        place_object_at(slide, child, info->parent->row + rowStep, info->parent->col + colStep,
+                        rowStep, colStep);
+        logDebugging(_logger,
+                     "Object '%s' resolved to position (%d, %d) with parent '%s' at (%d, %d) with "
+                     "position type %d",
+                     child->identifier, child->row, child->col, info->parent->identifier,
+                     info->parent->row, info->parent->col, info->pos_type);
+    }
+    g_ptr_array_free(order, TRUE);
     g_hash_table_destroy(dep_graph);
 }
 
-static gboolean resolve_object_position(PositionedObject *obj, GHashTable *dep_graph) {
-    DependencyInfo *info = g_hash_table_lookup(dep_graph, obj);
-    if (!info) {
-        // this object is not a child in any rule, so its position is its initial one
-        return TRUE;
-    }
-
-    if (info->is_resolved) {
-        return TRUE;
-    }
-    if (info->visit_state == NODE_VISITING) {
-        // Cycle detected
-        return FALSE;
+// Takes the objects out of the grid at once, and then fixes the bounds in a single pass (taking
+// them out one by one could rescan the slide for each one)
+static void lift_objects(Slide *slide, GPtrArray *objects) {
+    for (guint k = 0; k < objects->len; ++k) {
+        PositionedObject *obj = g_ptr_array_index(objects, k);
+        Row *row = g_hash_table_lookup(slide->rows, int_key(obj->row));
+        if (!row || row_lookup(row, obj->col) != obj)
+            continue;
+        row_steal(row, obj->col);
+        if (row->count == 0) {
+            g_hash_table_remove(slide->rows, int_key(obj->row));
+        }
     }
-
-    info->visit_state = NODE_VISITING;
-
-    // solve parent position FIRST (recursively)
-    if (!resolve_object_position(info->parent, dep_graph)) {
-        return FALSE;
+    GHashTableIter iter;
+    gpointer value;
+    g_hash_table_iter_init(&iter, slide->rows);
+    while (g_hash_table_iter_next(&iter, NULL, &value)) {
+        update_row_bounds(value);
     }
+    update_bounds(slide);
+}
 
-    DependencyInfo *parent_info = g_hash_table_lookup(dep_graph, info->parent);
-    int parent_row, parent_col;
-    if (parent_info) {
-        parent_row = parent_info->final_row;
-        parent_col = parent_info->final_col;
-    } else {
-        // Parent was not a child, so use its initial position
-        parent_row = info->parent->row;
-        parent_col = info->parent->col;
+// Reports the cycle that goes from the object in the chain up to the top of the chain
+static void report_cycle(Slide *slide, GPtrArray *chain, PositionedObject *obj) {
+    guint start = chain->len;
+    while (g_ptr_array_index(chain, --start) != obj)
+        ;
+    GString *cycle = g_string_new(NULL);
+    for (guint k = start; k < chain->len; ++k) {
+        PositionedObject *member = g_ptr_array_index(chain, k);
+        g_string_append_printf(cycle, "'%s' -> ", member->identifier);
     }
+    g_string_append_printf(cycle, "'%s'", obj->identifier);
+    report(slide, ERROR, "Cycle in the positioning rules for slide '%s': %s", slide->identifier,
+           cycle->str);
+    g_string_free(cycle, TRUE);
+}
 
-    info->final_row = parent_row;
-    info->final_col = parent_col;
-    switch (info->pos_type) {
+static void apply_position_offset(Position pos_type, int *row, int *col) {
+    switch (pos_type) {
     case POS_TOP:
-        info->final_row += 1;
+        *row += 1;
         break;
     case POS_BOTTOM:
-        info->final_row -= 1;
+        *row -= 1;
         break;
     case POS_LEFT:
-        info->final_col -= 1;
+        *col -= 1;
         break;
     case POS_RIGHT:
-        info->final_col += 1;
+        *col += 1;
         break;
     case POS_TOP_LEFT:
-        info->final_row += 1;
-        info->final_col -= 1;
+        *row += 1;
+        *col -= 1;
         break;
     case POS_TOP_RIGHT:
-        info->final_row += 1;
-        info->final_col += 1;
+        *row += 1;
+        *col += 1;
         break;
     case POS_BOTTOM_LEFT:
-        info->final_row -= 1;
-        info->final_col -= 1;
+        *row -= 1;
+        *col -= 1;
         break;
     case POS_BOTTOM_RIGHT:
-        info->final_row -= 1;
-        info->final_col += 1;
+        *row -= 1;
+        *col += 1;
         break;
     }
-    logDebugging(
-        _logger,
-        "Object '%s' resolved to position (%d, %d) with parent '%s' at (%d, %d) with position "
-        "type %d",
-        obj->identifier, info->final_row, info->final_col, info->parent->identifier, parent_row,
-        parent_col, info->pos_type);
-    info->visit_state = NODE_VISITED;
-    info->is_resolved = TRUE;
-    return TRUE;
+}
+
+// Every object has at most one parent, so each strongly connected component of the graph is either
+// a single object or a single cycle. Following the chain of parents with an explicit stack (instead
+// of recursing, which overflows with long chains) finds every cycle, and visits each object once.
+// Adds the children to the order, each one after its parent, and returns FALSE if there is any
+// cycle, after reporting all of them.
+static gboolean resolve_positions(Slide *slide, GHashTable *dep_graph, GPtrArray *children,
+                                  GPtrArray *order) {
+    GPtrArray *chain = g_ptr_array_new();
+    gboolean acyclic = TRUE;
+    for (guint k = 0; k < children->len; ++k) {
+        // Climb up until an object whose position is known, or one already in this chain
+        PositionedObject *obj = g_ptr_array_index(children, k);
+        DependencyInfo *info = g_hash_table_lookup(dep_graph, obj);
+        while (info != NULL && info->visit_state == NODE_UNVISITED) {
+            info->visit_state = NODE_VISITING;
+            g_ptr_array_add(chain, obj);
+            obj = info->parent;
+            info = g_hash_table_lookup(dep_graph, obj);
+        }
+
+        gboolean resolvable;
+        if (info == NULL) {
+            // this object is not a child in any rule, so its position is its initial one
+            resolvable = TRUE;
+        } else if (info->visit_state == NODE_VISITING) {
+            report_cycle(slide, chain, obj);
+            resolvable = FALSE;
+        } else {
+            // Visited by a previous chain, which either got resolved or ran into a cycle
+            resolvable = info->is_resolved;
+        }
+
+        // Climb down, so each object comes right after its parent
+        while (chain->len > 0) {
+            PositionedObject *child = g_ptr_array_remove_index_fast(chain, chain->len - 1);
+            DependencyInfo *child_info = g_hash_table_lookup(dep_graph, child);
+            child_info->visit_state = NODE_VISITED;
+            child_info->is_resolved = resolvable;
+            if (resolvable) {
+                g_ptr_array_add(order, child);
+            }
+        }
+        acyclic = acyclic && resolvable;
+    }
+    g_ptr_array_free(chain, TRUE);
+    return acyclic;
+}
+
+/******************************** frozen grid of a resolved slide ********************************/
+static int compare_rows_descending(const void *a, const void *b) {
+    int first = *(const int *)a;
+    int second = *(const int *)b;
+    return (first < second) - (first > second);
+}
+
+static int compare_cells_by_column(const void *a, const void *b) {
+    int first = ((const GridCell *)a)->col;
+    int second = ((const GridCell *)b)->col;
+    return (first > second) - (first < second);
+}
+
+// Once its layout is resolved, a slide only needs its occupied cells in order, so the hash tables
+// of rows and columns are replaced by a grid that the generator walks from start to end, and the
+// objects aren't looked up by symbol anymore. After this, the slide lives in its arena only.
+void freeze_layout(Slide *slide) {
+    Grid *grid = &slide->grid;
+    grid->rowCount = g_hash_table_size(slide->rows);
+    grid->rows = allocateInArena(slide->arena, grid->rowCount * sizeof(int));
+    grid->rowOffsets = allocateInArena(slide->arena, (grid->rowCount + 1) * sizeof(int));
+
+    int cellCount = 0;
+    int k = 0;
+    GHashTableIter iter;
+    gpointer key, value;
+    g_hash_table_iter_init(&iter, slide->rows);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+        grid->rows[k++] = GPOINTER_TO_INT(key);
+        cellCount += ((Row *)value)->count;
+    }
+    qsort(grid->rows, grid->rowCount, sizeof(int), compare_rows_descending);
+
+    grid->cells = allocateInArena(slide->arena, cellCount * sizeof(GridCell));
+    int cell = 0;
+    for (k = 0; k < grid->rowCount; ++k) {
+        Row *row = g_hash_table_lookup(slide->rows, int_key(grid->rows[k]));
+        grid->rowOffsets[k] = cell;
+        row_collect(row, grid->cells + cell);
+        qsort(grid->cells + cell, row->count, sizeof(GridCell), compare_cells_by_column);
+        cell += row->count;
+    }
+    grid->rowOffsets[grid->rowCount] = cell;
+
+    g_hash_table_destroy(slide->rows);
+    slide->rows = NULL;
+    g_hash_table_destroy(slide->symbolToObject);
+    slide->symbolToObject = NULL;
 }
 
 /*******************************************************************************************/
 
 /* Generate the slide objects for positioning */
-SlideList *generateObjects(Program *program) {
-    /* I iterate through all slides.. */
-    StructureDefinition *structureDefinition = program->structure_definitions;
 
-    SlideList *list = calloc(1, sizeof(SlideList));
-    list->head = NULL;
-    list->tail = NULL;
-    Slide *currentSlide = NULL;
-    for (StructureDefinition *structure = structureDefinition; structure != NULL;
-         structure = structure->next) {
+// A worker of the layout, which lays out a contiguous range of the structures (in source order)
+typedef struct {
+    TaskRange range; // Of the structures (see "runRanges")
+    ArenaArray *structures;
+    Slide **slides; // One slot for each structure, NULL if it has no content
+    CollisionPolicy collisionPolicy;
+    Arena *arena; // Of its slides, merged into the one of the list once every worker is done
+} LayoutWorker;
+
+// Each slide only touches its own structure and its own tables, so a range is laid out without
+// locks (see "runRanges")
+static gpointer layout_slides(gpointer data) {
+    LayoutWorker *worker = data;
+    for (guint k = worker->range.first; k < worker->range.last; ++k) {
+        StructureDefinition *structure =
+            &arenaArrayIndex(worker->structures, StructureDefinition, k);
         logDebugging(_logger, "Processing structure: %s", structure->identifier);
-        if (structure->content == NULL)
+        if (structure->content->len == 0)
             continue;
         // Create a new slide
-        Slide *slide = create_slide();
+        Slide *slide = create_slide(worker->arena);
         slide->identifier =
             structure->identifier; // I dont free this because the pointer is owned by the AST
+        slide->collisionPolicy = worker->collisionPolicy;
+        populate_slide_with_content(slide, structure->content);
+        apply_relative_positions(slide, structure->positions);
+        freeze_layout(slide);
+        worker->slides[k] = slide;
+    }
+    return NULL;
+}
+
+SlideList *generateObjects(Program *program, int workerCount, CollisionPolicy collisionPolicy) {
+    /* I iterate through all slides.. */
+    ArenaArray *structures = program->structure_definitions;
+    const guint slideCount = structures->len;
+
+    // Each range is laid out in its own thread (see "runRanges")
+    const guint workers = countWorkers(slideCount, workerCount, MINIMUM_SLIDES_PER_WORKER);
+    Slide **slides = calloc(MAX(slideCount, 1), sizeof(Slide *));
+    LayoutWorker *layoutWorkers = calloc(workers, sizeof(LayoutWorker));
+    for (guint k = 0; k < workers; ++k) {
+        layoutWorkers[k].structures = structures;
+        layoutWorkers[k].slides = slides;
+        layoutWorkers[k].collisionPolicy = collisionPolicy;
+        layoutWorkers[k].arena = createArena();
+    }
+    runRanges(slideCount, workers, layout_slides, layoutWorkers, sizeof(LayoutWorker));
+    SlideList *list = calloc(1, sizeof(SlideList));
+    list->arena = createArena();
+    for (guint k = 0; k < workers; ++k) {
+        mergeArena(list->arena, layoutWorkers[k].arena);
+    }
+    free(layoutWorkers);
 
-        // Prepend the new slide to the list. Because the parser gives us a reversed
-        // list of structures, prepending here puts them back in the correct order.
+    // The structures are in source order, and so are the slides. The arenas of the workers are
+    // merged into the one of the list, so each slide moves on to the arena of the list
+    list->head = NULL;
+    list->tail = NULL;
+    int objectCount = 0;
+    for (guint k = 0; k < slideCount; ++k) {
+        Slide *slide = slides[k];
+        if (slide == NULL)
+            continue;
+        slide->arena = list->arena;
+        log_diagnostics(slide);
+        list->errorCount += slide->collisionErrors;
+        objectCount += slide->grid.rowOffsets[slide->grid.rowCount];
         if (list->head == NULL) {
             list->head = slide;
-            list->tail = slide;
         } else {
-            slide->next = list->head;
-            list->head = slide;
+            list->tail->next = slide;
         }
-        populate_slide_with_content(slide, structure->content);
-        apply_relative_positions(slide, structure->positions);
+        list->tail = slide;
     }
-    for (Slide *slide = list->head; slide != NULL; slide = slide->next) {
-        logDebugging(_logger, "Slide '%s' has bounds: [%d, %d] x [%d, %d]", slide->identifier,
-                     slide->minRow, slide->maxRow, slide->minCol, slide->maxCol);
+    free(slides);
+
+    if (shouldLog(_logger, DEBUGGING)) {
+        for (Slide *slide = list->head; slide != NULL; slide = slide->next) {
+            logDebugging(_logger, "Slide '%s' has bounds: [%d, %d] x [%d, %d]", slide->identifier,
+                         slide->minRow, slide->maxRow, slide->minCol, slide->maxCol);
+        }
+        logDebugging(_logger, "Laid out %d objects in %zu bytes of the arena (%zu per object)",
+                     objectCount, list->arena->allocated,
+                     list->arena->allocated / MAX(objectCount, 1));
     }
     return list;
 }
 
 /**************************************** DESTRUCTORS *********************************************/
-void destroySlides(Slide *slide) {
-    if (!slide)
-        return;
-
-    destroySlides(slide->next);
-
-    if (slide->rows) {
-        g_hash_table_destroy(slide->rows);
-        slide->rows = NULL;
-    }
-    if (slide->symbolToObject) {
-        g_hash_table_destroy(slide->symbolToObject);
-        slide->symbolToObject = NULL;
-    }
-
-    g_free(slide);
-};
-
 void destroyObjects(SlideList *list) {
     logDebugging(_logger, "Executing destructor: %s", __FUNCTION__);
 
     if (!list)
         return;
 
-    destroySlides(list->head);
+    // The slides, their objects, their rows and their grids live in the arena of the list (their
+    // tables are gone since their layouts were frozen), so they're released at once
     list->head = NULL;
     list->tail = NULL;
+    destroyArena(list->arena);
     free(list);
 }
@@ -15,7 +15,9 @@
 void initializeObjectsModule();
 void shutdownObjectsModule();
 
-SlideList *generateObjects(Program *program);
+// Lays out the slides with up to "workerCount" threads (one for each processor, if it's 0), and lists
+// them in source order. Two objects in the same cell are handled with the collision policy.
+SlideList *generateObjects(Program *program, int workerCount, CollisionPolicy collisionPolicy);
 void destroyObjects(SlideList *slides);
 
 /* Helper */
@@ -1,15 +1,18 @@
 /* Take a list of cssProperties and
-** turn them into a string of formatted css properties
-** based on the cases we accept for each object */
+** write them as a css rule straight into the output,
+** based on the schema of the properties (see PROPERTY_SCHEMA in Type.h) */
 
 #ifndef PROPERTIES_HEADER
 #define PROPERTIES_HEADER
+#include "../../shared/Arena.h"
+#include "../../shared/CssValue.h"
+#include "../../shared/OutputSink.h"
+#include "../../shared/PropertySchema.h"
 #include "../../shared/Type.h"
 #include <stdio.h>
-/* Parse a series of css properties and  */
-
-char *parseImageProperties(CssProperty *properties);
-char *parseTextblockProperties(CssProperty *properties);
-char *parseSlideProperties(CssProperty *properties);
+/* Writes the rule ".identifier {\n" + "name: value;\n" for each accepted property + " }\n".
+** Returns false (and writes nothing) if none of the properties is accepted for the type. */
+boolean writeCssRule(OutputSink *output, const char *identifier, ObjectType type,
+                     ArenaArray *properties);
 
 #endif
\ No newline at end of file
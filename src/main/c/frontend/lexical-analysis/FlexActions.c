@@ -25,6 +25,9 @@ static void _logLexicalAnalyzerContext(const char *functionName,
 /* Logs a lexical-analyzer context in DEBUGGING level */
 static void _logLexicalAnalyzerContext(const char *functionName,
                                        LexicalAnalyzerContext *lexicalAnalyzerContext) {
+    if (!shouldLog(_logger, DEBUGGING)) {
+        return;
+    }
     char *escapedLexeme = escape(lexicalAnalyzerContext->lexeme);
     logDebugging(_logger, "%s: %s (context = %d, length = %d, line = %d)", functionName,
                  escapedLexeme, lexicalAnalyzerContext->currentContext,
@@ -38,115 +41,118 @@ void BeginMultilineCommentLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerCo
     if (_logIgnoredLexemes) {
         _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
     }
-    destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
 }
 
 void EndMultilineCommentLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext) {
     if (_logIgnoredLexemes) {
         _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
     }
-    destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
 }
 
 void IgnoredLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext) {
     if (_logIgnoredLexemes) {
         _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
     }
-    destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
 }
 
 Token OpenBraceLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext, Token token) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
     lexicalAnalyzerContext->semanticValue->token = token;
-    destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
     return OPEN_CURLY_BRACE;
 }
 
 Token CloseBraceLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext, Token token) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
     lexicalAnalyzerContext->semanticValue->token = token;
-    destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
     return CLOSE_CURLY_BRACE;
 }
 
 Token IntegerLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
     lexicalAnalyzerContext->semanticValue->integer = atoi(lexicalAnalyzerContext->lexeme);
-    destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
     return INTEGER;
 }
 
 Token DecimalLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
     lexicalAnalyzerContext->semanticValue->decimal = atof(lexicalAnalyzerContext->lexeme);
-    destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
     return DECIMAL;
 }
 
 Token ColonLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext, Token token) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
     lexicalAnalyzerContext->semanticValue->token = token;
-    destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
     return COLON;
 }
 
 Token SemiColonLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext, Token token) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
     lexicalAnalyzerContext->semanticValue->token = token;
-    destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
     return SEMICOLON;
 }
 
 Token StringLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
 
-    // Strip quotes from the beginning and end of the string
-    char *lexeme = lexicalAnalyzerContext->lexeme;
+    // Strip quotes from the beginning and end of the string, without copying it: the lexeme lies in
+    // the source buffer, which outlives the code generation
+    const char *lexeme = lexicalAnalyzerContext->lexeme;
     int length = lexicalAnalyzerContext->length;
 
     if (length >= 2 && lexeme[0] == '"' && lexeme[length - 1] == '"') {
-        char *strippedString =
-            malloc(length - 1); // -1 for null terminator, +1 for content, -2 for quotes
-        if (strippedString) {
-            strncpy(strippedString, lexeme + 1, length - 2);
-            strippedString[length - 2] = '\0';
-            lexicalAnalyzerContext->semanticValue->string = strippedString;
-        } else {
-            lexicalAnalyzerContext->semanticValue->string = strdup(lexicalAnalyzerContext->lexeme);
-        }
-    } else {
-        lexicalAnalyzerContext->semanticValue->string = strdup(lexicalAnalyzerContext->lexeme);
+        lexeme++;
+        length -= 2;
     }
-
-    destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
+    // ...unless the scanner reads a stream, whose buffers don't outlive the next chunk
+    if (lexicalAnalyzerContext->streaming) {
+        lexeme = internSlice(lexicalAnalyzerContext->compilerState->stringPool, lexeme, length);
+    }
+    lexicalAnalyzerContext->semanticValue->slice = (Slice){lexeme, length};
     return STRING;
 }
 
 /* Identifies the names of variables and so on */
 Token IdentifierLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
-    lexicalAnalyzerContext->semanticValue->string = strdup(lexicalAnalyzerContext->lexeme);
-    destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
+    lexicalAnalyzerContext->semanticValue->string =
+        intern(lexicalAnalyzerContext->compilerState->stringPool, lexicalAnalyzerContext->lexeme);
     return IDENTIFIER;
 }
 
 Token PropertyLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
-    lexicalAnalyzerContext->semanticValue->string = strdup(lexicalAnalyzerContext->lexeme);
-    destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
+    lexicalAnalyzerContext->semanticValue->string =
+        intern(lexicalAnalyzerContext->compilerState->stringPool, lexicalAnalyzerContext->lexeme);
     return PROPERTY;
 }
 
+/* Lengths and colors are parsed right away; the malformed ones remain keywords */
+Token LengthLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext) {
+    if (!parseLength(lexicalAnalyzerContext->lexeme, lexicalAnalyzerContext->length,
+                     &lexicalAnalyzerContext->semanticValue->length)) {
+        return PropertyLexemeAction(lexicalAnalyzerContext);
+    }
+    _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
+    return LENGTH;
+}
+
+Token ColorLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext) {
+    if (!parseColor(lexicalAnalyzerContext->lexeme, lexicalAnalyzerContext->length,
+                    &lexicalAnalyzerContext->semanticValue->color)) {
+        return PropertyLexemeAction(lexicalAnalyzerContext);
+    }
+    _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
+    return COLOR;
+}
+
 Token KeywordLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext, Token token) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
     lexicalAnalyzerContext->semanticValue->token = token;
-    destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
     return token;
 }
 
 /* Rejects invalid syntax */
 Token UnknownLexemeAction(LexicalAnalyzerContext *lexicalAnalyzerContext) {
     _logLexicalAnalyzerContext(__FUNCTION__, lexicalAnalyzerContext);
-    destroyLexicalAnalyzerContext(lexicalAnalyzerContext);
     return UNKNOWN;
 }
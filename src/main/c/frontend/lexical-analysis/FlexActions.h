@@ -1,6 +1,7 @@
 #ifndef FLEX_ACTIONS_HEADER
 #define FLEX_ACTIONS_HEADER
 
+#include "../../shared/CssValue.h"
 #include "../../shared/Environment.h"
 #include "../../shared/Logger.h"
 #include "../../shared/String.h"
@@ -29,6 +30,8 @@ Token DecimalLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
 Token StringLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
 Token IdentifierLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
 Token PropertyLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
+Token LengthLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
+Token ColorLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext);
 
 Token SemiColonLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext, Token token);
 Token ColonLexemeAction(LexicalAnalyzerContext * lexicalAnalyzerContext, Token token);
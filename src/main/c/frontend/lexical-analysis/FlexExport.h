@@ -4,10 +4,23 @@
 /**
  * Hook that allows to export a static function or variable from the inside of
  * Flex infrastructure, in this case, the current context (a.k.a. start
- * condition).
+ * condition) of the scanner.
  */
-unsigned int flexCurrentContext(void) {
+unsigned int flexCurrentContext(yyscan_t yyscanner) {
+	struct yyguts_t * yyg = (struct yyguts_t *) yyscanner;
 	return YY_START;
 }
 
+/**
+ * Hook that makes the scanner work over the given text in place, instead of
+ * copying it from "yyin" into its own buffers. The size includes the two NUL
+ * characters that must end the text. The buffer state is released along with
+ * the scanner (see "yylex_destroy"), but the text is not.
+ *
+ * @see https://westes.github.io/flex/manual/Multiple-Input-Buffers.html
+ */
+boolean flexScanBuffer(char * text, size_t size, yyscan_t yyscanner) {
+	return yy_scan_buffer(text, size, yyscanner) != NULL;
+}
+
 #endif
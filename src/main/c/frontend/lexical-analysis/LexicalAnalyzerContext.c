@@ -1,44 +1,38 @@
 #include "LexicalAnalyzerContext.h"
 
 /**
- * Flex exported variables and functions.
+ * Flex exported variables and functions. In a reentrant scanner, every one of
+ * them is a field of the scanner, reached through its accessor.
  *
- * @see https://westes.github.io/flex/manual/User-Values.html
+ * @see https://westes.github.io/flex/manual/Accessor-Methods.html
  */
 
-// The wrapper of "yy_top_state" function (provided by Flex).
-extern unsigned int flexCurrentContext(void);
+// The wrapper of "YY_START" macro (provided by Flex).
+extern unsigned int flexCurrentContext(yyscan_t scanner);
+
+// The context of the scanner, set on creation (provided by Flex).
+extern LexicalAnalyzerContext * yyget_extra(yyscan_t scanner);
 
 // The lexeme length in characters (provided by Flex).
-extern int yyleng;
+extern int yyget_leng(yyscan_t scanner);
 
 // The line number (provided by Flex).
-extern int yylineno;
+extern int yyget_lineno(yyscan_t scanner);
 
-// The semantic value of the lookahead symbol (provided by Bison).
-extern union SemanticValue yylval;
+// The semantic value of the lookahead symbol (provided by Bison, through Flex).
+extern union SemanticValue * yyget_lval(yyscan_t scanner);
 
 // The current lexeme (provided by Flex).
-extern char * yytext;
+extern char * yyget_text(yyscan_t scanner);
 
 /* PUBLIC FUNCTIONS */
 
-LexicalAnalyzerContext * createLexicalAnalyzerContext() {
-	LexicalAnalyzerContext * lexicalAnalyzerContext = calloc(1, sizeof(LexicalAnalyzerContext));
-	lexicalAnalyzerContext->length = yyleng;
-	lexicalAnalyzerContext->lexeme = calloc(1 + yyleng, sizeof(char));
-	lexicalAnalyzerContext->line = yylineno;
-	lexicalAnalyzerContext->semanticValue = &yylval;
-	lexicalAnalyzerContext->currentContext = flexCurrentContext();
-	strncpy(lexicalAnalyzerContext->lexeme, yytext, yyleng);
+LexicalAnalyzerContext * currentLexicalAnalyzerContext(yyscan_t scanner) {
+	LexicalAnalyzerContext * lexicalAnalyzerContext = yyget_extra(scanner);
+	lexicalAnalyzerContext->length = yyget_leng(scanner);
+	lexicalAnalyzerContext->lexeme = yyget_text(scanner);
+	lexicalAnalyzerContext->line = yyget_lineno(scanner);
+	lexicalAnalyzerContext->currentContext = flexCurrentContext(scanner);
+	lexicalAnalyzerContext->semanticValue = yyget_lval(scanner);
 	return lexicalAnalyzerContext;
 }
-
-void destroyLexicalAnalyzerContext(LexicalAnalyzerContext * lexicalAnalyzerContext) {
-	if (lexicalAnalyzerContext != NULL) {
-		if (lexicalAnalyzerContext->lexeme != NULL) {
-			free(lexicalAnalyzerContext->lexeme);
-		}
-		free(lexicalAnalyzerContext);
-	}
-}
@@ -1,30 +1,45 @@
 #ifndef LEXICAL_ANALYZER_CONTEXT_HEADER
 #define LEXICAL_ANALYZER_CONTEXT_HEADER
 
+#include "../../shared/CompilerState.h"
 #include <stdlib.h>
 #include <string.h>
 
 /**
- * The state of a lexical-analyzer context.
+ * The opaque state of a reentrant Flex scanner.
+ *
+ * @see https://westes.github.io/flex/manual/Reentrant-Detail.html
+ */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void * yyscan_t;
+#endif
+
+/**
+ * The state of a lexical-analyzer context. The lexeme is not a copy: it
+ * points straight into the Flex buffer, so it's only valid until the next
+ * token gets scanned.
  */
 typedef struct {
 	unsigned int currentContext;
 	unsigned int length;
-	char * lexeme;
+	const char * lexeme;
 	unsigned int line;
 	union SemanticValue * semanticValue;
-} LexicalAnalyzerContext;
 
-/**
- * Creates a new context with the current state of the lexical-analyzer over
- * the lexeme just consumed. The lexeme is a deep-copy of the original,
- * allocated in heap-memory.
- */
-LexicalAnalyzerContext * createLexicalAnalyzerContext();
+	// Whether the scanner reads a stream, whose text gets overwritten as new
+	// chunks arrive (instead of scanning the source buffer in place).
+	boolean streaming;
+
+	// The compilation this scanner works for.
+	CompilerState * compilerState;
+} LexicalAnalyzerContext;
 
 /**
- * Destroy a lexical-analyzer context and its resources.
+ * Refreshes the context of the scanner (its "yyextra") with the lexeme just
+ * consumed, and returns it. Each scanner reuses the same context for every
+ * token, so nothing gets allocated and there is nothing to release.
  */
-void destroyLexicalAnalyzerContext(LexicalAnalyzerContext * lexicalAnalyzerContext);
+LexicalAnalyzerContext * currentLexicalAnalyzerContext(yyscan_t scanner);
 
 #endif
@@ -0,0 +1,164 @@
+#include "SourceBuffer.h"
+#include <errno.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+
+// Initial capacity when the text has to be read.
+static const size_t _initialCapacity = 64 * 1024;
+
+void initializeSourceBufferModule() {
+    _logger = createLogger("SourceBuffer");
+}
+
+void shutdownSourceBufferModule() {
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+    }
+}
+
+/* PRIVATE FUNCTIONS */
+
+static SourceBuffer *_createSourceBuffer(char *text, size_t length, size_t capacity,
+                                         boolean mapped) {
+    SourceBuffer *sourceBuffer = calloc(1, sizeof(SourceBuffer));
+    sourceBuffer->text = text;
+    sourceBuffer->length = length;
+    sourceBuffer->capacity = capacity;
+    sourceBuffer->mapped = mapped;
+    logDebugging(_logger, "Source of %zu bytes %s", length, mapped ? "mapped" : "read");
+    return sourceBuffer;
+}
+
+/* PUBLIC FUNCTIONS */
+
+#ifdef _WIN32
+
+SourceBuffer *openSourceFile(const char *path) {
+    FILE *stream = fopen(path, "rb");
+    if (stream == NULL) {
+        logError(_logger, "Cannot open '%s': %s", path, strerror(errno));
+        return NULL;
+    }
+    SourceBuffer *sourceBuffer = readSourceStream(stream);
+    fclose(stream);
+    return sourceBuffer;
+}
+
+#else
+
+SourceBuffer *openSourceFile(const char *path) {
+    const int descriptor = open(path, O_RDONLY);
+    struct stat status;
+    if (descriptor < 0 || fstat(descriptor, &status) < 0) {
+        logError(_logger, "Cannot open '%s': %s", path, strerror(errno));
+        if (descriptor >= 0) {
+            close(descriptor);
+        }
+        return NULL;
+    }
+    if (!S_ISREG(status.st_mode)) {
+        FILE *stream = fdopen(descriptor, "rb");
+        SourceBuffer *sourceBuffer = readSourceStream(stream);
+        fclose(stream);
+        return sourceBuffer;
+    }
+
+    // Reserve zeroed pages for the text and the sentinel, and map the file over the first ones.
+    // The tail of the last page of the file reads as zeros too, so the sentinel only lands on a
+    // page of its own when the file ends near a page boundary.
+    const size_t length = status.st_size;
+    const size_t pageSize = sysconf(_SC_PAGESIZE);
+    const size_t capacity =
+        (length + SOURCE_BUFFER_SENTINEL_LENGTH + pageSize - 1) / pageSize * pageSize;
+    char *text =
+        mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (text == MAP_FAILED) {
+        logError(_logger, "Cannot map '%s': %s", path, strerror(errno));
+        close(descriptor);
+        return NULL;
+    }
+    if (0 < length && mmap(text, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+                           descriptor, 0) == MAP_FAILED) {
+        logError(_logger, "Cannot map '%s': %s", path, strerror(errno));
+        munmap(text, capacity);
+        close(descriptor);
+        return NULL;
+    }
+    close(descriptor);
+    return _createSourceBuffer(text, length, capacity, true);
+}
+
+#endif
+
+SourceBuffer *readSourceStream(FILE *stream) {
+    size_t capacity = _initialCapacity;
+    size_t length = 0;
+    size_t count;
+    char *text = malloc(capacity);
+    while ((count = fread(text + length, 1, capacity - length - SOURCE_BUFFER_SENTINEL_LENGTH,
+                          stream)) > 0) {
+        length += count;
+        if (capacity - length == SOURCE_BUFFER_SENTINEL_LENGTH) {
+            capacity *= 2;
+            text = realloc(text, capacity);
+        }
+    }
+    if (ferror(stream)) {
+        logError(_logger, "Cannot read the input program: %s", strerror(errno));
+        free(text);
+        return NULL;
+    }
+    memset(text + length, '\0', SOURCE_BUFFER_SENTINEL_LENGTH);
+    return _createSourceBuffer(text, length, capacity, false);
+}
+
+#ifdef _WIN32
+
+size_t readSourceChunk(FILE *stream, char *buffer, size_t size) {
+    const size_t count = fread(buffer, 1, size, stream);
+    if (count == 0 && ferror(stream)) {
+        logError(_logger, "Cannot read the input program: %s", strerror(errno));
+    }
+    return count;
+}
+
+#else
+
+size_t readSourceChunk(FILE *stream, char *buffer, size_t size) {
+    ssize_t count;
+    do {
+        count = read(fileno(stream), buffer, size);
+    } while (count < 0 && errno == EINTR);
+    if (count < 0) {
+        logError(_logger, "Cannot read the input program: %s", strerror(errno));
+        return 0;
+    }
+    return count;
+}
+
+#endif
+
+void closeSourceBuffer(SourceBuffer *sourceBuffer) {
+    if (sourceBuffer == NULL) {
+        return;
+    }
+#ifndef _WIN32
+    if (sourceBuffer->mapped) {
+        munmap(sourceBuffer->text, sourceBuffer->capacity);
+        free(sourceBuffer);
+        return;
+    }
+#endif
+    free(sourceBuffer->text);
+    free(sourceBuffer);
+}
@@ -0,0 +1,58 @@
+#ifndef SOURCE_BUFFER_HEADER
+#define SOURCE_BUFFER_HEADER
+
+#include "../../shared/Logger.h"
+#include "../../shared/Type.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Flex scans a buffer in place only if the text is followed by two NUL characters.
+ *
+ * @see https://westes.github.io/flex/manual/Multiple-Input-Buffers.html
+ */
+#define SOURCE_BUFFER_SENTINEL_LENGTH 2
+
+/**
+ * The whole text of the input program, followed by the sentinel Flex expects. Lexemes and strings
+ * are slices of this text, so the buffer must outlive the code-generation phase.
+ */
+typedef struct {
+    char *text;
+    size_t length;   // Without the sentinel
+    size_t capacity; // Bytes mapped or allocated
+    boolean mapped;
+} SourceBuffer;
+
+/** Initialize module's internal state. */
+void initializeSourceBufferModule();
+
+/** Shutdown module's internal state. */
+void shutdownSourceBufferModule();
+
+/**
+ * Maps the file in memory. The mapping is private (copy-on-write), because Flex writes into the
+ * buffer while scanning. Files that can't be mapped (e.g., pipes) are read instead.
+ * @return The source buffer, or NULL if the file can't be read.
+ */
+SourceBuffer *openSourceFile(const char *path);
+
+/**
+ * Reads the stream until its end.
+ * @return The source buffer, or NULL if the stream can't be read.
+ */
+SourceBuffer *readSourceStream(FILE *stream);
+
+/**
+ * Reads whatever the stream has available, up to the size given, waiting only if there is nothing
+ * yet. Unlike "fread", it doesn't wait for a pipe or socket to fill the whole buffer.
+ * @return The bytes read, or 0 at the end of the stream (or on error).
+ */
+size_t readSourceChunk(FILE *stream, char *buffer, size_t size);
+
+/**
+ * Unmaps or releases the text, and the buffer itself. Every slice taken from it becomes invalid.
+ */
+void closeSourceBuffer(SourceBuffer *sourceBuffer);
+
+#endif
@@ -0,0 +1,315 @@
+#include "SemanticAnalyzer.h"
+
+/* MODULE INTERNAL STATE */
+
+// With fewer slides (or animations) than this for each worker, a thread costs more than it saves
+#define MINIMUM_TASKS_PER_WORKER 512
+
+/**
+ * A worker of the semantic analysis, which checks a range of the structures (or the animations) in
+ * source order. It writes nothing shared but the nodes in its range and the objects of its slides,
+ * and its diagnostics are logged once every worker is done.
+ */
+typedef struct {
+    TaskRange range; // Of the definitions (see "runRanges")
+    CompilerState *compilerState;
+    ArenaArray *definitions; // Of StructureDefinition or AnimationDefinition
+    GPtrArray *diagnostics;  // Of messages, in source order
+} SemanticWorker;
+
+static Logger *_logger = NULL;
+
+void initializeSemanticAnalyzerModule() { _logger = createLogger("SemanticAnalyzer"); }
+
+void shutdownSemanticAnalyzerModule() {
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+    }
+}
+
+/* PRIVATE FUNCTIONS */
+
+static void _reportError(SemanticWorker *worker, const char *format, ...) {
+    va_list arguments;
+    va_start(arguments, format);
+    g_ptr_array_add(worker->diagnostics, g_strdup_vprintf(format, arguments));
+    va_end(arguments);
+}
+
+/**
+ * Warns about each property of the object that isn't in the schema, doesn't apply to the type of
+ * the object, or doesn't accept its kind of value: it's left out of the presentation.
+ */
+static void _checkProperties(ObjectDefinition *object) {
+    ArenaArray *properties = object->css_properties;
+    for (guint k = 0; properties != NULL && k < properties->len; ++k) {
+        CssProperty *property = &arenaArrayIndex(properties, CssProperty, k);
+        if (property->key == PROP_UNKNOWN) {
+            logWarning(_logger, "Unknown property '%s' of object '%s' is ignored.",
+                       property->property_name, object->identifier);
+        } else if (!isPropertyOf(property->key, object->type)) {
+            logWarning(_logger, "Property '%s' doesn't apply to object '%s', so it's ignored.",
+                       property->property_name, object->identifier);
+        } else if (!acceptsValue(property->key, property->value_type)) {
+            logWarning(_logger, "Property '%s' of object '%s' has a kind of value it doesn't "
+                                "accept, so it's ignored.",
+                       property->property_name, object->identifier);
+        }
+    }
+}
+
+/**
+ * Adds every object to the symbol table, in source order (so the duplicate of an object is the
+ * definition that comes after it, and the properties of the object are the ones of the last one).
+ */
+static void _indexObjects(CompilerState *compilerState, ArenaArray *objects) {
+    for (guint k = 0; k < objects->len; ++k) {
+        ObjectDefinition *object = &arenaArrayIndex(objects, ObjectDefinition, k);
+        if (symbolExists(compilerState->symbolTable, object->identifier)) {
+            logError(_logger, "Duplicate object with identifier '%s' already exists.",
+                     object->identifier);
+            compilerState->errorCount++;
+        }
+        _checkProperties(object);
+        SymbolId symbol = addSymbol(compilerState->symbolTable, object->identifier, object->type);
+        getSymbolById(compilerState->symbolTable, symbol)->properties = object->css_properties;
+    }
+}
+
+/**
+ * Numbers the slides in source order. A slide with many structures keeps the number of the first
+ * one, which is the only one whose positionings are checked.
+ */
+static void _numberSlides(CompilerState *compilerState, ArenaArray *structures) {
+    for (guint k = 0; k < structures->len; ++k) {
+        StructureDefinition *structure = &arenaArrayIndex(structures, StructureDefinition, k);
+        SymbolTableItem *item = getSymbol(compilerState->symbolTable, structure->identifier);
+        if (item != NULL && item->currentSlide == (-1)) {
+            item->currentSlide = k;
+        }
+    }
+    reserveSlides(compilerState->symbolTable, structures->len);
+    compilerState->slideCounter = structures->len;
+}
+
+/**
+ * Sets the string of each object, which is the last one it was added with.
+ */
+static void _assignStrings(CompilerState *compilerState, ArenaArray *structures) {
+    for (guint k = 0; k < structures->len; ++k) {
+        ArenaArray *contents = arenaArrayIndex(structures, StructureDefinition, k).content;
+        for (guint j = 0; j < contents->len; ++j) {
+            SlideContent *addition = &arenaArrayIndex(contents, SlideContent, j);
+            SymbolTableItem *item = getSymbolById(compilerState->symbolTable, addition->add.symbol);
+            if (item != NULL) {
+                item->string = addition->add.with_string;
+            }
+        }
+    }
+}
+
+static void _checkAddition(SemanticWorker *worker, int slide, SlideContent *addition) {
+    SymbolTable *symbolTable = worker->compilerState->symbolTable;
+    char *identifier = addition->add.identifier;
+    addition->add.symbol = findSymbol(symbolTable, identifier);
+    if (addition->add.symbol == NO_SYMBOL) {
+        _reportError(worker, "Object with identifier '%s' does not exist.", identifier);
+        return;
+    }
+    // Check if the item has already been added to this specific slide
+    if (!addToSlide(symbolTable, slide, addition->add.symbol)) {
+        _reportError(worker, "Repeated object %s in a single slide", identifier);
+    }
+}
+
+static void _checkPositioning(SemanticWorker *worker, SlideContent *positioning) {
+    SymbolTable *symbolTable = worker->compilerState->symbolTable;
+    char *relative = positioning->position_items.child;
+    char *fixed = positioning->position_items.parent;
+    positioning->position_items.childSymbol = findSymbol(symbolTable, relative);
+    positioning->position_items.parentSymbol = findSymbol(symbolTable, fixed);
+    SymbolTableItem *relativeItem =
+        getSymbolById(symbolTable, positioning->position_items.childSymbol);
+    SymbolTableItem *fixedItem =
+        getSymbolById(symbolTable, positioning->position_items.parentSymbol);
+    if (relativeItem == NULL || relativeItem->type == OBJ_SLIDE) {
+        _reportError(worker, "Object with identifier '%s' does not exist or is a slide", relative);
+    }
+    if (fixedItem == NULL || fixedItem->type == OBJ_SLIDE) {
+        _reportError(worker, "Object with identifier '%s' does not exist or is a slide", fixed);
+    }
+    /* In domain specific the rest of the semantic checks to see if positioning is valid */
+}
+
+static void _checkStructure(SemanticWorker *worker, int slide, StructureDefinition *structure) {
+    SymbolTable *symbolTable = worker->compilerState->symbolTable;
+    ArenaArray *contents = structure->content;
+    ArenaArray *positions = structure->positions;
+    for (guint k = 0; k < contents->len; ++k) {
+        _checkAddition(worker, slide, &arenaArrayIndex(contents, SlideContent, k));
+    }
+    for (guint k = 0; k < positions->len; ++k) {
+        _checkPositioning(worker, &arenaArrayIndex(positions, SlideContent, k));
+    }
+
+    char *identifier = structure->identifier;
+    SymbolTableItem *item = getSymbol(symbolTable, identifier);
+    if (item == NULL) {
+        _reportError(worker, "Object with identifier '%s' does not exist.", identifier);
+    } else if (item->type != OBJ_SLIDE) {
+        _reportError(worker, "Object with identifier '%s' is not a slide.", identifier);
+    }
+    if (item != NULL && item->currentSlide == slide) {
+        // Check that all position directives are defined in the slide structure
+        // Its costly to parse the list but we are avoiding unnecesary checks in code generation
+        // stage later
+        for (guint k = 0; k < positions->len; ++k) {
+            SlideContent *content = &arenaArrayIndex(positions, SlideContent, k);
+            if (content->position_items.childSymbol == NO_SYMBOL ||
+                content->position_items.parentSymbol == NO_SYMBOL) {
+                _reportError(worker,
+                             "Positioning not allowed because one or more objects do not exist");
+            } else {
+                if (!isInSlide(symbolTable, slide, content->position_items.childSymbol)) {
+                    _reportError(worker,
+                                 "Invalid positioning of item %s, item is not present in slide %d",
+                                 content->position_items.child, slide);
+                }
+                if (!isInSlide(symbolTable, slide, content->position_items.parentSymbol)) {
+                    _reportError(worker,
+                                 "Invalid positioning of item %s, item is not present in slide %d",
+                                 content->position_items.parent, slide);
+                }
+            }
+        }
+    }
+}
+
+static void _checkAnimationStep(SemanticWorker *worker, AnimationStep *step) {
+    SymbolTable *symbolTable = worker->compilerState->symbolTable;
+    step->symbol = findSymbol(symbolTable, step->identifier);
+    SymbolTableItem *item = getSymbolById(symbolTable, step->symbol);
+    if (item == NULL) {
+        _reportError(worker, "Object with identifier '%s' does not exist.", step->identifier);
+    } else if (item->type == OBJ_SLIDE) {
+        _reportError(worker, "Object with identifier '%s' is a slide!!", step->identifier);
+    }
+}
+
+static void _checkAnimation(SemanticWorker *worker, AnimationDefinition *animation) {
+    SymbolTable *symbolTable = worker->compilerState->symbolTable;
+    switch (animation->kind) {
+    case ANIM_DEF_PAIR: {
+        SymbolTableItem *slideItem = getSymbol(symbolTable, animation->pair.identifier1);
+        if (slideItem == NULL || slideItem->type != OBJ_SLIDE) {
+            _reportError(worker, "Object with identifier '%s' does not exist or is not a slide.",
+                         animation->pair.identifier1);
+        }
+        break;
+    }
+    case ANIM_DEF_SEQUENCE: {
+        ArenaArray *steps = animation->sequence.steps;
+        for (guint k = 0; k < steps->len; ++k) {
+            _checkAnimationStep(worker, &arenaArrayIndex(steps, AnimationStep, k));
+        }
+        SymbolTableItem *slideItem = getSymbol(symbolTable, animation->sequence.identifier);
+        if (slideItem == NULL || slideItem->type != OBJ_SLIDE) {
+            _reportError(worker, "Object with identifier '%s' does not exist or is not a slide.",
+                         animation->sequence.identifier);
+        }
+        if (slideItem == NULL) {
+            /* If item is not a slide or doesnt exist we cant check this because theres no slide to
+             * compare it to */
+            break;
+        }
+        for (guint k = 0; k < steps->len; ++k) {
+            AnimationStep *step = &arenaArrayIndex(steps, AnimationStep, k);
+            if (step->symbol == NO_SYMBOL ||
+                !isInSlide(symbolTable, slideItem->currentSlide, step->symbol)) {
+                _reportError(
+                    worker, "Object with identifier '%s' does not exist or is not part of slide %d.",
+                    step->identifier, slideItem->currentSlide);
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/**
+ * Checks the structures of a worker (see "runRanges"). The number of a slide is the index of
+ * its structure.
+ */
+static gpointer _checkStructures(gpointer data) {
+    SemanticWorker *worker = data;
+    for (guint k = worker->range.first; k < worker->range.last; ++k) {
+        _checkStructure(worker, k, &arenaArrayIndex(worker->definitions, StructureDefinition, k));
+    }
+    return NULL;
+}
+
+/**
+ * Checks the animations of a worker (see "runRanges").
+ */
+static gpointer _checkAnimations(gpointer data) {
+    SemanticWorker *worker = data;
+    for (guint k = worker->range.first; k < worker->range.last; ++k) {
+        _checkAnimation(worker, &arenaArrayIndex(worker->definitions, AnimationDefinition, k));
+    }
+    return NULL;
+}
+
+/**
+ * Splits the definitions in contiguous ranges, one for each worker, and checks each range in its
+ * own thread (see "runRanges"). Then, it logs the diagnostics of every worker in order, so they
+ * are the same, in the same order, no matter the number of workers.
+ */
+static void _runWorkers(CompilerState *compilerState, ArenaArray *definitions,
+                        const int requestedWorkers, GThreadFunc check) {
+    const guint taskCount = definitions->len;
+    const guint workerCount = countWorkers(taskCount, requestedWorkers, MINIMUM_TASKS_PER_WORKER);
+    SemanticWorker *workers = calloc(workerCount, sizeof(SemanticWorker));
+    for (guint k = 0; k < workerCount; ++k) {
+        workers[k].compilerState = compilerState;
+        workers[k].definitions = definitions;
+        workers[k].diagnostics = g_ptr_array_new_with_free_func(g_free);
+    }
+    runRanges(taskCount, workerCount, check, workers, sizeof(SemanticWorker));
+    for (guint k = 0; k < workerCount; ++k) {
+        for (guint j = 0; j < workers[k].diagnostics->len; ++j) {
+            logError(_logger, "%s", (char *)g_ptr_array_index(workers[k].diagnostics, j));
+        }
+        compilerState->errorCount += workers[k].diagnostics->len;
+        g_ptr_array_free(workers[k].diagnostics, TRUE);
+    }
+    free(workers);
+}
+
+/* PUBLIC FUNCTIONS */
+
+boolean analyzeSemantics(CompilerState *compilerState, int workerCount) {
+    logDebugging(_logger, "Analyzing semantics...");
+    Program *program = compilerState->abstractSyntaxtTree;
+
+    // The objects and the slide numbers are shared by every check, so they come first
+    ArenaArray *structures = program->structure_definitions;
+    _indexObjects(compilerState, program->object_definitions);
+    _numberSlides(compilerState, structures);
+
+    // Each slide is checked on its own, and the animations once every slide has its objects
+    _runWorkers(compilerState, structures, workerCount, _checkStructures);
+    _assignStrings(compilerState, structures);
+    ArenaArray *animations = program->animation_definitions;
+    if (animations != NULL) {
+        _runWorkers(compilerState, animations, workerCount, _checkAnimations);
+    }
+
+    logDebugging(_logger, "Semantic analysis is done.");
+    if (compilerState->errorCount > 0) {
+        logError(_logger, "There are %d semantic errors.", compilerState->errorCount);
+        compilerState->succeed = false;
+    }
+    return compilerState->succeed;
+}
@@ -0,0 +1,30 @@
+#ifndef SEMANTIC_ANALYZER_HEADER
+#define SEMANTIC_ANALYZER_HEADER
+
+#include "../../shared/CompilerState.h"
+#include "../../shared/Logger.h"
+#include "../../shared/Parallel.h"
+#include "../../shared/PropertySchema.h"
+#include "../../shared/SymbolTable.h"
+#include "../syntactic-analysis/AbstractSyntaxTree.h"
+
+/** Initialize module's internal state. */
+void initializeSemanticAnalyzerModule();
+
+/** Shutdown module's internal state. */
+void shutdownSemanticAnalyzerModule();
+
+/**
+ * Executes every semantic check, once the whole program is parsed (the join step of the frontend):
+ * objects must be declared once, and every object added, positioned or animated must be declared in
+ * the Objects section, and must be added to the slide it is positioned or animated in. Slides are
+ * numbered in source order, and the string of each object is the last one it was added with.
+ *
+ * Once the objects are in the symbol table, the slides are checked in parallel, and then the
+ * animations, with up to "workerCount" threads (if it's 0, as many as it's worth, up to one for
+ * each processor; see "MINIMUM_TASKS_PER_WORKER"). The errors are logged in source order anyway.
+ * @return Whether the program is valid (if not, the errors are logged).
+ */
+boolean analyzeSemantics(CompilerState *compilerState, int workerCount);
+
+#endif
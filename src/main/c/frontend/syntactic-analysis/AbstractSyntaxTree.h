@@ -1,6 +1,7 @@
 #ifndef ABSTRACT_SYNTAX_TREE_HEADER
 #define ABSTRACT_SYNTAX_TREE_HEADER
 
+#include "../../shared/Arena.h"
 #include "../../shared/Logger.h"
 #include "../../shared/Type.h"
 #include <stdlib.h>
@@ -13,6 +14,24 @@ void shutdownAbstractSyntaxTreeModule();
 
 /*
  * Node types for the Abstract Syntax Tree (AST).
+ *
+ * Every identifier, property name and property value is an atom of the
+ * compilation's string pool, and the text of an "add-with" block is a slice
+ * that borrows from the source buffer (or from the string pool, when the
+ * source is read as a stream), so the tree owns no strings: the source
+ * buffer and the pool must outlive it.
+ *
+ * Every sequence of nodes (objects, properties, structures, slide contents,
+ * animations and animation steps) is an array of the nodes themselves, in
+ * source order, so its length is known and it's walked over contiguous memory.
+ *
+ * Every node and every array lives in the arena of the compilation, which
+ * releases the whole tree at once (see "Arena.h"), so there are no
+ * destructors.
+ *
+ * The identifiers used by slide contents and animation steps are resolved to
+ * their symbols by the semantic analysis, so the backend never looks up a
+ * name (they stay NO_SYMBOL until then).
  */
 
 // Some object types in Type.h because they are shared
@@ -20,9 +39,8 @@ void shutdownAbstractSyntaxTreeModule();
 // Struct for object definition (slide, textblock, image)
 typedef struct ObjectDefinition {
     ObjectType type;
-    char *identifier;            // Name of the object
-    CssProperty *css_properties; // Linked list of properties
-    struct ObjectDefinition *next;
+    char *identifier;           // Name of the object
+    ArenaArray *css_properties; // Of CssProperty
 } ObjectDefinition;
 
 // Slide content types
@@ -40,7 +58,8 @@ typedef struct SlideContent {
     union {
         struct {
             char *identifier;
-            char *with_string; // NULL if none
+            Slice with_string; // A slice of the source text
+            SymbolId symbol;
         } add;
 
         // Position anchor;
@@ -48,21 +67,21 @@ typedef struct SlideContent {
             char *child;
             Position pos;
             char *parent;
+            SymbolId childSymbol;
+            SymbolId parentSymbol;
         } position_items;
         struct {
             char *identifier;
             Position pos;
         } position_item;
     };
-    struct SlideContent *next; // linked list of slide content items
 } SlideContent;
 
 // Struct for structure sentence
 typedef struct StructureDefinition {
     char *identifier;
-    SlideContent *content; // Linked list of slide contents
-    SlideContent *positions;
-    struct StructureDefinition *next;
+    ArenaArray *content;   // Of SlideContent (additions)
+    ArenaArray *positions; // Of SlideContent (positionings)
 } StructureDefinition;
 
 typedef enum {
@@ -80,14 +99,12 @@ typedef enum {
     ANIM_DEF_PAIR,     // To animate slide transitions
 } AnimationDefinitionKind;
 
-typedef struct AnimationStep AnimationStep;
-
 // Struct for animation step: THEN IDENTIFIER animation_type
-struct AnimationStep {
+typedef struct AnimationStep {
     char *identifier;
     AnimationType type;
-    AnimationStep *next;
-};
+    SymbolId symbol;
+} AnimationStep;
 
 typedef struct AnimationDefinition {
     AnimationDefinitionKind kind;
@@ -98,33 +115,23 @@ typedef struct AnimationDefinition {
         } single;
         struct {
             char *identifier;
-            AnimationStep *steps; // Linked list of steps
-            int repeat_count;     // 1 if no repeat, otherwise repeat times
+            ArenaArray *steps; // Of AnimationStep
+            int repeat_count;  // 1 if no repeat, otherwise repeat times
         } sequence;
         struct {
             char *identifier1;
             AnimationType type;
         } pair;
     };
-    struct AnimationDefinition *next;
 } AnimationDefinition;
 
 /************************************* OUR PROGRAM ************************************************/
 
 typedef struct {
     char *presentation_identifier;
-    ObjectDefinition *object_definitions;
-    StructureDefinition *structure_definitions;
-    AnimationDefinition *animation_definitions;
+    ArenaArray *object_definitions;    // Of ObjectDefinition
+    ArenaArray *structure_definitions; // Of StructureDefinition
+    ArenaArray *animation_definitions; // Of AnimationDefinition (NULL if there is no section)
 } Program;
 
-/*
- * Node recursive destructors
- */
-void destroyProgram(Program *program);
-
-void releaseAnimationsSection(AnimationDefinition *animationList);
-void releaseObjectsSection(ObjectDefinition *objectList);
-void releaseStructureSection(StructureDefinition *structureList);
-
 #endif
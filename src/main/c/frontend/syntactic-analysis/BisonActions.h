@@ -3,6 +3,7 @@
 
 #include "../../shared/CompilerState.h"
 #include "../../shared/Logger.h"
+#include "../../shared/PropertySchema.h"
 #include "../../shared/Type.h"
 #include "AbstractSyntaxTree.h"
 #include "SyntacticAnalyzer.h"
@@ -15,51 +16,48 @@ void initializeBisonActionsModule();
 void shutdownBisonActionsModule();
 
 /*
- * Bison semantic actions.
+ * Bison semantic actions. They only build the tree: every check (the symbol
+ * table included) runs once the whole program is parsed (see
+ * "SemanticAnalyzer.h").
  */
 
-Program *ProgramSemanticAction(CompilerState *compilerState, char *presName,
-                               ObjectDefinition *objectList, StructureDefinition *structureList,
-                               AnimationDefinition *animationList);
+Program *ProgramSemanticAction(CompilerState *compilerState, char *presName, ArenaArray *objectList,
+                               ArenaArray *structureList, ArenaArray *animationList);
 
-ObjectDefinition *ObjectListSemanticAction(ObjectDefinition *objectList,
-                                           ObjectDefinition *newObject);
-ObjectDefinition *ObjectDefinitionSemanticAction(CompilerState *compilerState, ObjectType type,
-                                                 char *identifier, CssProperty *cssProperties);
+// Every sequence begins empty, and each node is appended to it (see "AbstractSyntaxTree.h")
+ArenaArray *EmptyListSemanticAction(CompilerState *compilerState, guint elementSize);
 
-CssProperty *PropertyListSemanticAction(CssProperty *propertyList, CssProperty *newProperty);
+ArenaArray *ObjectListSemanticAction(ArenaArray *objectList, ObjectDefinition newObject);
+ObjectDefinition ObjectDefinitionSemanticAction(ObjectType type, char *identifier,
+                                                ArenaArray *cssProperties);
 
-CssProperty *PropertySemanticAction(char *propertyName, char *value);
-CssProperty *PropertyNumberSemanticAction(char *propertyName, int value);
-CssProperty *PropertyDecimalSemanticAction(char *propertyName, float value);
+ArenaArray *PropertyListSemanticAction(ArenaArray *propertyList, CssProperty newProperty);
 
-StructureDefinition *StructureListSemanticAction(StructureDefinition *structureList,
-                                                 StructureDefinition *newStructure);
-StructureDefinition *StructureDefinitionSemanticAction(CompilerState *CompilerState,
-                                                       char *identifier, SlideContent *content,
-                                                       SlideContent *positions);
+CssProperty PropertySemanticAction(char *propertyName, char *value);
+CssProperty PropertyNumberSemanticAction(char *propertyName, int value);
+CssProperty PropertyDecimalSemanticAction(char *propertyName, float value);
+CssProperty PropertyLengthSemanticAction(char *propertyName, Length value);
+CssProperty PropertyColorSemanticAction(char *propertyName, Color value);
 
-SlideContent *SlidePositionContentListSemanticAction(SlideContent *slideContentList,
-                                                     SlideContent *newSlideContent);
-SlideContent *SlideContentListSemanticAction(SlideContent *slideContentList,
-                                             SlideContent *newSlideContent);
-SlideContent *AdditionSlideContent(CompilerState *compilerState, char *identifier, char *content);
-// SlideContent * AnchorPositionSlideContent(Position position);
-// SlideContent * RelativeSimplePositionSlideContent(char * relative , Position position);
-SlideContent *RelativeDoublePositionSlideContent(CompilerState *compilerState, char *relative,
-                                                 char *fixed, Position position);
+ArenaArray *StructureListSemanticAction(ArenaArray *structureList, StructureDefinition newStructure);
+StructureDefinition StructureDefinitionSemanticAction(char *identifier, ArenaArray *content,
+                                                      ArenaArray *positions);
 
-AnimationDefinition *AnimationListSemanticAction(AnimationDefinition *animationList,
-                                                 AnimationDefinition *newAnimation);
-AnimationDefinition *AnimationDefinitionSemanticAction(char *identifier, AnimationType type);
-AnimationDefinition *AnimationDefinitionSequenceSemanticAction(CompilerState *compilerState,
-                                                               char *identifier,
-                                                               AnimationStep *steps, int repeat);
-AnimationDefinition *AnimationDefinitionPairSemanticAction(CompilerState *CompilerState,
-                                                           char *identifier1, AnimationType type);
+ArenaArray *SlidePositionContentListSemanticAction(ArenaArray *slideContentList,
+                                               SlideContent newSlideContent);
+ArenaArray *SlideContentListSemanticAction(ArenaArray *slideContentList, SlideContent newSlideContent);
+SlideContent AdditionSlideContent(char *identifier, Slice content);
+// SlideContent AnchorPositionSlideContent(Position position);
+// SlideContent RelativeSimplePositionSlideContent(char * relative , Position position);
+SlideContent RelativeDoublePositionSlideContent(char *relative, char *fixed, Position position);
 
-AnimationStep *AnimationSequenceSemanticAction(AnimationStep *new, AnimationStep *steps);
-AnimationStep *AnimationStepSemanticAction(CompilerState *compilerState, char *identifier,
-                                           AnimationType type);
+ArenaArray *AnimationListSemanticAction(ArenaArray *animationList, AnimationDefinition newAnimation);
+AnimationDefinition AnimationDefinitionSemanticAction(char *identifier, AnimationType type);
+AnimationDefinition AnimationDefinitionSequenceSemanticAction(char *identifier, ArenaArray *steps,
+                                                              int repeat);
+AnimationDefinition AnimationDefinitionPairSemanticAction(char *identifier1, AnimationType type);
+
+ArenaArray *AnimationSequenceSemanticAction(ArenaArray *steps, AnimationStep new);
+AnimationStep AnimationStepSemanticAction(char *identifier, AnimationType type);
 
 #endif
@@ -4,38 +4,71 @@
 
 %}
 
+%code requires {
+
+#include "../../shared/CompilerState.h"
+
+/** The opaque state of the reentrant Flex scanner. */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void * yyscan_t;
+#endif
+
+}
+
 // You touch this, and you die.
 %define api.value.union.name SemanticValue
 
+/**
+ * A pure parser keeps its state in the stack of "yyparse", and receives the
+ * scanner and the compilation it works for, so many parsers can run at the
+ * same time.
+ *
+ * @see https://www.gnu.org/software/bison/manual/html_node/Pure-Decl.html
+ */
+%define api.pure full
+%lex-param {yyscan_t scanner}
+%parse-param {yyscan_t scanner} {CompilerState * compilerState}
+
+/**
+ * Besides "yyparse", which pulls every token from the scanner, generate a
+ * push parser, which takes the tokens one at a time and reduces as soon as it
+ * can ("yypush_parse"), for the input that arrives through a stream.
+ *
+ * @see https://www.gnu.org/software/bison/manual/html_node/Push-Decl.html
+ */
+%define api.push-pull both
+
 %union {
 	/** Terminals. */
 	int integer;
 	Token token;
 	char * string;
+	Slice slice;
 	float decimal;
+	Length length;
+	Color color;
 	Position position;
 	AnimationType animation_type;
 
-	/** Non-terminals. */
-	AnimationDefinition * animation_definition;
-	AnimationStep * animation_step;
-	ObjectDefinition * object_definition;
-	CssProperty * css_property;
-	StructureDefinition * structure_definition;
-	SlideContent * slide_content;
+	/** Non-terminals. Every sequence is an array of nodes, in source order. */
+	AnimationDefinition animation_definition;
+	AnimationStep animation_step;
+	ObjectDefinition object_definition;
+	CssProperty css_property;
+	StructureDefinition structure_definition;
+	SlideContent slide_content;
+	ArenaArray * list;
 	Program * program;
 }
 
 /**
- * Destructors. This functions are executed after the parsing ends, so if the
- * AST must be used in the following phases of the compiler you shouldn't used
- * this approach for the AST root node ("program" non-terminal, in this
- * grammar), or it will drop the entire tree even if the parse succeeds.
+ * There are no destructors: every node lives in the arena of the compilation,
+ * so the ones discarded by an error are released along with the rest of the
+ * tree (see "Arena.h").
  *
  * @see https://www.gnu.org/software/bison/manual/html_node/Destructor-Decl.html
  */
-%destructor { releaseStructureSection($$); } structure
-%destructor { releaseAnimationsSection($$); } animation
 
 /** Terminals. */
 
@@ -45,9 +78,11 @@
 %token <token> STRUCTURE	
 
 /* Built in data types */
-%token <string> STRING
+%token <slice> STRING
 %token <integer> INTEGER
 %token <decimal> DECIMAL
+%token <length> LENGTH
+%token <color> COLOR
 
 /* Naming variables and CSS properties */
 %token <string> IDENTIFIER
@@ -88,35 +123,41 @@
 /* To log errors*/
 %token <token> UNKNOWN
 
+/* Entry points of the sections parsed apart (never scanned, see "parseSections") */
+%token <token> PARSE_OBJECTS
+%token <token> PARSE_STRUCTURE
+%token <token> PARSE_ANIMATIONS
+
 /** Non-terminals. */
 %type <program> program
+%type <program> section
 
 %type <position> simple_position
 %type <position> compound_position
 %type <slide_content> slide_content
-%type <slide_content> slide_contents
-%type <slide_content> position_contents
+%type <list> slide_contents
+%type <list> position_contents
 %type <slide_content> position_content
 
 %type <structure_definition> structure_definition
-%type <structure_definition> structure_definitions
-%type <structure_definition> structure
+%type <list> structure_definitions
+%type <list> structure
 
 %type <css_property> css_property
-%type <css_property> css_properties
+%type <list> css_properties
 
 %type <object_definition> object_definition
-%type <object_definition> object_definitions
-%type <object_definition> objects
+%type <list> object_definitions
+%type <list> objects
 
 %type <animation_type> animation_type
 %type <animation_type> animation_type_slides
 
 %type <animation_step> animation_step
-%type <animation_step> animation_sequence
+%type <list> animation_sequence
 %type <animation_definition> animation_definition
-%type <animation_definition> animation_definitions
-%type <animation_definition> animation
+%type <list> animation_definitions
+%type <list> animation
 
 /**
  * Precedence and associativity.
@@ -127,26 +168,37 @@
 %%
 
 // IMPORTANT: To use λ in the following grammar, use the %empty symbol. -> should use it for empty structure or objects, or animations! 
+/* A whole program, or one of its sections: each one ends where the next one begins */
+entry:
+	program
+	| section
+	;
+section:
+	PARSE_OBJECTS PRESENTATION IDENTIFIER OPEN_CURLY_BRACE objects PARSE_STRUCTURE				{ $$ = ProgramSemanticAction(compilerState, $3, $5, NULL, NULL); }
+	| PARSE_STRUCTURE structure PARSE_ANIMATIONS 												{ $$ = ProgramSemanticAction(compilerState, NULL, NULL, $2, NULL); }
+	| PARSE_STRUCTURE structure CLOSE_CURLY_BRACE 												{ $$ = ProgramSemanticAction(compilerState, NULL, NULL, $2, NULL); }
+	| PARSE_ANIMATIONS animation CLOSE_CURLY_BRACE 												{ $$ = ProgramSemanticAction(compilerState, NULL, NULL, NULL, $2); }
+	;
 /* Only animations section is optional */
 program: 
-	PRESENTATION IDENTIFIER OPEN_CURLY_BRACE objects structure animation CLOSE_CURLY_BRACE      { $$ = ProgramSemanticAction(currentCompilerState(), $2, $4, $5, $6); }
-	|PRESENTATION IDENTIFIER OPEN_CURLY_BRACE objects structure CLOSE_CURLY_BRACE 			   	{ $$ = ProgramSemanticAction(currentCompilerState(), $2, $4, $5, NULL); }
+	PRESENTATION IDENTIFIER OPEN_CURLY_BRACE objects structure animation CLOSE_CURLY_BRACE      { $$ = ProgramSemanticAction(compilerState, $2, $4, $5, $6); }
+	|PRESENTATION IDENTIFIER OPEN_CURLY_BRACE objects structure CLOSE_CURLY_BRACE 			   	{ $$ = ProgramSemanticAction(compilerState, $2, $4, $5, NULL); }
 	;
 objects:
 	OBJECT OPEN_CURLY_BRACE object_definitions CLOSE_CURLY_BRACE  								{ $$ = $3; }						
 	;
 object_definitions:
-	%empty 																						{ $$ = NULL; }											
+	%empty 																						{ $$ = EmptyListSemanticAction(compilerState, sizeof(ObjectDefinition)); }											
 	|object_definitions object_definition									    				{ $$ = ObjectListSemanticAction($1,$2); }	
 	;  
 
 object_definition:
-	SLIDE IDENTIFIER OPEN_CURLY_BRACE css_properties CLOSE_CURLY_BRACE 							{ $$ = ObjectDefinitionSemanticAction(currentCompilerState(), OBJ_SLIDE, $2, $4); }
-	|TEXTBLOCK IDENTIFIER OPEN_CURLY_BRACE css_properties CLOSE_CURLY_BRACE 					{ $$ = ObjectDefinitionSemanticAction(currentCompilerState(), OBJ_TEXTBLOCK, $2, $4); }
-	|IMAGE IDENTIFIER OPEN_CURLY_BRACE css_properties CLOSE_CURLY_BRACE 						{ $$ = ObjectDefinitionSemanticAction(currentCompilerState(), OBJ_IMAGE, $2, $4); }
+	SLIDE IDENTIFIER OPEN_CURLY_BRACE css_properties CLOSE_CURLY_BRACE 							{ $$ = ObjectDefinitionSemanticAction(OBJ_SLIDE, $2, $4); }
+	|TEXTBLOCK IDENTIFIER OPEN_CURLY_BRACE css_properties CLOSE_CURLY_BRACE 					{ $$ = ObjectDefinitionSemanticAction(OBJ_TEXTBLOCK, $2, $4); }
+	|IMAGE IDENTIFIER OPEN_CURLY_BRACE css_properties CLOSE_CURLY_BRACE 						{ $$ = ObjectDefinitionSemanticAction(OBJ_IMAGE, $2, $4); }
 	;
 css_properties:
-	%empty 																						{ $$ = NULL; }											
+	%empty 																						{ $$ = EmptyListSemanticAction(compilerState, sizeof(CssProperty)); }											
 	| css_properties css_property																{ $$ = PropertyListSemanticAction($1, $2); }	
 	;
 css_property:
@@ -154,36 +206,38 @@ css_property:
 	| PROPERTY COLON DECIMAL SEMICOLON 															{ $$ = PropertyDecimalSemanticAction($1, $3); }
 	|PROPERTY COLON PROPERTY SEMICOLON 															{ $$ = PropertySemanticAction($1, $3); }
 	| PROPERTY COLON INTEGER SEMICOLON 															{ $$ = PropertyNumberSemanticAction($1, $3); }
+	| PROPERTY COLON LENGTH SEMICOLON 															{ $$ = PropertyLengthSemanticAction($1, $3); }
+	| PROPERTY COLON COLOR SEMICOLON 															{ $$ = PropertyColorSemanticAction($1, $3); }
 	; 
 structure:
 	STRUCTURE OPEN_CURLY_BRACE structure_definitions CLOSE_CURLY_BRACE 							{ $$ = $3; }
 	;
 structure_definitions:
-	%empty 																						{ $$ = NULL; }										
+	%empty 																						{ $$ = EmptyListSemanticAction(compilerState, sizeof(StructureDefinition)); }										
 	| structure_definitions structure_definition												{ $$ = StructureListSemanticAction($1, $2); }											
 	;
 structure_definition:
-	IDENTIFIER OPEN_CURLY_BRACE slide_contents position_contents CLOSE_CURLY_BRACE 				{ $$ = StructureDefinitionSemanticAction(currentCompilerState(),$1, $3, $4); }
+	IDENTIFIER OPEN_CURLY_BRACE slide_contents position_contents CLOSE_CURLY_BRACE 				{ $$ = StructureDefinitionSemanticAction($1, $3, $4); }
 	;
 
 slide_contents:
-	%empty 																						{ $$ = NULL; }											
+	%empty 																						{ $$ = EmptyListSemanticAction(compilerState, sizeof(SlideContent)); }											
 	| slide_contents slide_content																{ $$ = SlideContentListSemanticAction($1, $2); }	
 	;
 
 slide_content:
-	ADD IDENTIFIER SEMICOLON 																	{ $$ = AdditionSlideContent(currentCompilerState(),$2, NULL); }
-	| ADD IDENTIFIER WITH STRING SEMICOLON 														{ $$ = AdditionSlideContent(currentCompilerState(),$2, $4); }
+	ADD IDENTIFIER SEMICOLON 																	{ $$ = AdditionSlideContent($2, (Slice) {NULL, 0}); }
+	| ADD IDENTIFIER WITH STRING SEMICOLON 														{ $$ = AdditionSlideContent($2, $4); }
 	;
 
 position_contents:
-	%empty 																						{ $$ = NULL; }											
+	%empty 																						{ $$ = EmptyListSemanticAction(compilerState, sizeof(SlideContent)); }											
 	| position_contents position_content														{ $$ = SlidePositionContentListSemanticAction($1,$2); }
 	;
 
 position_content:
-	IDENTIFIER simple_position IDENTIFIER SEMICOLON  											{ $$ = RelativeDoublePositionSlideContent(currentCompilerState(),$1, $3, $2); }
-	| IDENTIFIER compound_position IDENTIFIER SEMICOLON  										{ $$ = RelativeDoublePositionSlideContent(currentCompilerState(),$1, $3, $2); }
+	IDENTIFIER simple_position IDENTIFIER SEMICOLON  											{ $$ = RelativeDoublePositionSlideContent($1, $3, $2); }
+	| IDENTIFIER compound_position IDENTIFIER SEMICOLON  										{ $$ = RelativeDoublePositionSlideContent($1, $3, $2); }
 
 	;
 
@@ -204,20 +258,20 @@ animation:
 	;
 
 animation_definitions:
-	%empty 																						{ $$ = NULL; }											
+	%empty 																						{ $$ = EmptyListSemanticAction(compilerState, sizeof(AnimationDefinition)); }											
 	| animation_definitions animation_definition												{ $$ = AnimationListSemanticAction($1,$2); }
 	;
 animation_definition:
-	animation_type_slides IDENTIFIER SEMICOLON													{ $$ = AnimationDefinitionPairSemanticAction(currentCompilerState(), $2, $1); }
-	| IDENTIFIER START animation_sequence END SEMICOLON											{ $$ = AnimationDefinitionSequenceSemanticAction(currentCompilerState(),$1, $3, 1); }
-	| IDENTIFIER START animation_sequence END REPEAT INTEGER SEMICOLON							{ $$ = AnimationDefinitionSequenceSemanticAction(currentCompilerState(),$1, $3, $6); }
+	animation_type_slides IDENTIFIER SEMICOLON													{ $$ = AnimationDefinitionPairSemanticAction($2, $1); }
+	| IDENTIFIER START animation_sequence END SEMICOLON											{ $$ = AnimationDefinitionSequenceSemanticAction($1, $3, 1); }
+	| IDENTIFIER START animation_sequence END REPEAT INTEGER SEMICOLON							{ $$ = AnimationDefinitionSequenceSemanticAction($1, $3, $6); }
 	;
 animation_sequence:
-	%empty 																						{ $$ = NULL; }											
-	|  animation_step  	animation_sequence														{ $$ = AnimationSequenceSemanticAction($2, $1); }	
+	%empty 																						{ $$ = EmptyListSemanticAction(compilerState, sizeof(AnimationStep)); }											
+	| animation_sequence animation_step															{ $$ = AnimationSequenceSemanticAction($1, $2); }	
 	;
 animation_step:
-	THEN IDENTIFIER animation_type							               						{ $$ = AnimationStepSemanticAction(currentCompilerState(),$2, $3); }		
+	THEN IDENTIFIER animation_type							               						{ $$ = AnimationStepSemanticAction($2, $3); }		
 	;
 animation_type:
 	APPEAR																						{ $$ = ANIM_APPEAR; }
@@ -1,9 +1,9 @@
 #include "SyntacticAnalyzer.h"
-#include "../lexical-analysis/LexicalAnalyzerContext.h"
+#include "AbstractSyntaxTree.h"
+#include "BisonParser.h"
 
 /* MODULE INTERNAL STATE */
 
-static CompilerState * _currentCompilerState = NULL;
 static Logger * _logger = NULL;
 
 void initializeSyntacticAnalyzerModule() {
@@ -18,7 +18,22 @@ void shutdownSyntacticAnalyzerModule() {
 
 /** IMPORTED FUNCTIONS */
 
-extern LexicalAnalyzerContext * createLexicalAnalyzerContext();
+extern unsigned int flexCurrentContext(yyscan_t scanner);
+
+extern boolean flexScanBuffer(char * text, size_t size, yyscan_t scanner);
+
+/**
+ * Flex exported functions.
+ *
+ * @see https://westes.github.io/flex/manual/Init-and-Destroy-Functions.html
+ */
+extern int yylex_init_extra(LexicalAnalyzerContext * lexicalAnalyzerContext, yyscan_t * scanner);
+
+extern int yylex_destroy(yyscan_t scanner);
+
+extern void yyset_in(FILE * stream, yyscan_t scanner);
+
+extern void yyset_lineno(int line, yyscan_t scanner);
 
 /**
  * Bison exported functions.
@@ -31,25 +46,146 @@ extern LexicalAnalyzerContext * createLexicalAnalyzerContext();
  *
  * @see https://www.gnu.org/software/bison/manual/html_node/Parser-Function.html
  */
-extern int yyparse(void);
+extern int yyparse(yyscan_t scanner, CompilerState * compilerState);
+
+/**
+ * Bison push-parser, fed with one token at a time.
+ *
+ * @see https://www.gnu.org/software/bison/manual/html_node/Push-Parser-Interface.html
+ */
+extern yypstate * yypstate_new(void);
+
+extern int yypush_parse(yypstate * parserState, int token, union SemanticValue const * semanticValue, yyscan_t scanner, CompilerState * compilerState);
+
+extern void yypstate_delete(yypstate * parserState);
 
 // Bison error-reporting function.
-void yyerror(const char * string) {
-	LexicalAnalyzerContext * lexicalAnalyzerContext = createLexicalAnalyzerContext();
+void yyerror(yyscan_t scanner, CompilerState * compilerState, const char * string) {
+	LexicalAnalyzerContext * lexicalAnalyzerContext = currentLexicalAnalyzerContext(scanner);
 	logError(_logger, "Syntax error (on line %d).", lexicalAnalyzerContext->line);
 }
 
-/* PUBLIC FUNCTIONS */
+/**
+ * Where a top-level keyword was found by the pre-scan.
+ */
+typedef struct {
+	boolean found;
+	size_t offset;
+	int line;
+} SectionKeyword;
+
+/**
+ * A top-level section of the program, parsed by its own scanner and parser,
+ * over its own copy of the compiler state (it shares the symbol table and the
+ * string pool, but builds its own tree in its own arena, and counts its own
+ * errors).
+ */
+typedef struct {
+	char * text;
+	size_t size;		// Including the two NUL characters that end the section
+	int line;
+	Token startToken;	// Pushed before the tokens of the section
+	Token keywordToken;	// The keyword that the previous section overwrote, if any
+	Token nextToken;	// The start token of the next section, if any
+	CompilerState compilerState;
+	SyntacticAnalysisStatus status;
+} Section;
+
+/* PRIVATE FUNCTIONS */
 
-CompilerState * currentCompilerState() {
-	return _currentCompilerState;
+/**
+ * Whether the keyword starts at the offset, as a whole word.
+ */
+static boolean _isKeywordAt(const char * text, const size_t length, const size_t offset, const char * keyword) {
+	const size_t keywordLength = strlen(keyword);
+	if (length < offset + keywordLength || strncmp(text + offset, keyword, keywordLength) != 0) {
+		return false;
+	}
+	const char previous = (offset == 0) ? ' ' : text[offset - 1];
+	const char next = (offset + keywordLength == length) ? ' ' : text[offset + keywordLength];
+	return !(g_ascii_isalnum(previous) || previous == '_' || g_ascii_isalnum(next) || next == '_');
 }
 
-SyntacticAnalysisStatus parse(CompilerState * compilerState) {
-	logDebugging(_logger, "Parsing...");
-	_currentCompilerState = compilerState;
-	const int code = yyparse();
-	_currentCompilerState = NULL;
+/**
+ * Finds the keywords of the Structure and Animations sections in a single
+ * pass, skipping strings and comments. Only keywords right inside the braces
+ * of the presentation count.
+ * @return Whether the program can be split in sections (otherwise it's parsed
+ * as a whole, which reports its errors).
+ */
+static boolean _findSections(const char * text, const size_t length, SectionKeyword * structure, SectionKeyword * animations) {
+	int depth = 0;
+	int line = 1;
+	for (size_t k = 0; k < length; ++k) {
+		const char * skipTo = NULL;
+		if (text[k] == '"') {
+			skipTo = memchr(text + k + 1, '"', length - k - 1);
+		}
+		else if (text[k] == '/' && k + 1 < length && text[k + 1] == '*') {
+			skipTo = g_strstr_len(text + k + 2, length - k - 2, "*/");
+			skipTo = (skipTo == NULL) ? NULL : skipTo + 1;
+		}
+		else if (text[k] == '\n') {
+			++line;
+			continue;
+		}
+		else if (text[k] == '{') {
+			++depth;
+			continue;
+		}
+		else if (text[k] == '}') {
+			--depth;
+			continue;
+		}
+		else if (depth == 1 && _isKeywordAt(text, length, k, "Structure")) {
+			if (structure->found) {
+				return false;
+			}
+			*structure = (SectionKeyword) {true, k, line};
+			continue;
+		}
+		else if (depth == 1 && _isKeywordAt(text, length, k, "Animations")) {
+			if (!structure->found || animations->found) {
+				return false;
+			}
+			*animations = (SectionKeyword) {true, k, line};
+			continue;
+		}
+		else {
+			continue;
+		}
+		// An unterminated string or comment
+		if (skipTo == NULL) {
+			return false;
+		}
+		for (const char * character = text + k; character < skipTo; ++character) {
+			line += (*character == '\n');
+		}
+		k = skipTo - text;
+	}
+	return structure->found;
+}
+
+/**
+ * Pushes a token that wasn't scanned.
+ */
+static int _pushToken(yypstate * parserState, const Token token, yyscan_t scanner, CompilerState * compilerState) {
+	union SemanticValue semanticValue = {
+		.token = token
+	};
+	return yypush_parse(parserState, token, &semanticValue, scanner, compilerState);
+}
+
+/**
+ * Checks the final state of the scanner, and translates the code returned by
+ * Bison into the status of the syntactic analysis.
+ */
+static SyntacticAnalysisStatus _finishParsing(CompilerState * compilerState, yyscan_t scanner, const int code) {
+	if (code == 0 && 0 < flexCurrentContext(scanner)) {
+		logError(_logger, "The final context is not the default (0): %d", flexCurrentContext(scanner));
+		compilerState->succeed = false;
+	}
+	yylex_destroy(scanner);
 	SyntacticAnalysisStatus syntacticAnalysisStatus;
 	logDebugging(_logger, "Parsing is done.");
 	switch (code) {
@@ -74,3 +210,174 @@ SyntacticAnalysisStatus parse(CompilerState * compilerState) {
 	compilerState->succeed = false;
 	return syntacticAnalysisStatus;
 }
+
+/**
+ * Parses a section, in place. It can run in any thread (see "g_thread_new").
+ */
+static gpointer _parseSection(gpointer data) {
+	Section * section = data;
+	LexicalAnalyzerContext lexicalAnalyzerContext = {
+		.compilerState = &section->compilerState,
+		.streaming = false
+	};
+	yyscan_t scanner;
+	if (yylex_init_extra(&lexicalAnalyzerContext, &scanner) != 0) {
+		logError(_logger, "Flex cannot create a scanner.");
+		section->status = OUT_OF_MEMORY;
+		return NULL;
+	}
+	yypstate * parserState = yypstate_new();
+	if (parserState == NULL || !flexScanBuffer(section->text, section->size, scanner)) {
+		logError(_logger, "Flex cannot scan the section, or Bison cannot create a push-parser.");
+		yypstate_delete(parserState);
+		yylex_destroy(scanner);
+		section->status = UNKNOWN_ERROR;
+		return NULL;
+	}
+	yyset_lineno(section->line, scanner);
+	int code = _pushToken(parserState, section->startToken, scanner, &section->compilerState);
+	if (code == YYPUSH_MORE && section->keywordToken != 0) {
+		code = _pushToken(parserState, section->keywordToken, scanner, &section->compilerState);
+	}
+	union SemanticValue semanticValue;
+	while (code == YYPUSH_MORE) {
+		const int token = yylex(&semanticValue, scanner);
+		if (token == 0) {
+			break;
+		}
+		code = yypush_parse(parserState, token, &semanticValue, scanner, &section->compilerState);
+	}
+	if (code == YYPUSH_MORE && section->nextToken != 0) {
+		code = _pushToken(parserState, section->nextToken, scanner, &section->compilerState);
+	}
+	if (code == YYPUSH_MORE) {
+		code = _pushToken(parserState, 0, scanner, &section->compilerState);
+	}
+	yypstate_delete(parserState);
+	section->status = _finishParsing(&section->compilerState, scanner, code);
+	return NULL;
+}
+
+
+/* PUBLIC FUNCTIONS */
+
+SyntacticAnalysisStatus parse(CompilerState * compilerState, SourceBuffer * sourceBuffer) {
+	logDebugging(_logger, "Parsing...");
+	LexicalAnalyzerContext lexicalAnalyzerContext = {
+		.compilerState = compilerState,
+		.streaming = false
+	};
+	yyscan_t scanner;
+	if (yylex_init_extra(&lexicalAnalyzerContext, &scanner) != 0) {
+		logError(_logger, "Flex cannot create a scanner.");
+		return OUT_OF_MEMORY;
+	}
+	if (!flexScanBuffer(sourceBuffer->text, sourceBuffer->length + SOURCE_BUFFER_SENTINEL_LENGTH, scanner)) {
+		logError(_logger, "Flex cannot scan the source buffer.");
+		yylex_destroy(scanner);
+		return UNKNOWN_ERROR;
+	}
+	return _finishParsing(compilerState, scanner, yyparse(scanner, compilerState));
+}
+
+SyntacticAnalysisStatus parseSections(CompilerState * compilerState, SourceBuffer * sourceBuffer) {
+	SectionKeyword structure = {false, 0, 0};
+	SectionKeyword animations = {false, 0, 0};
+	if (!_findSections(sourceBuffer->text, sourceBuffer->length, &structure, &animations)) {
+		logDebugging(_logger, "The program can't be split in sections.");
+		return parse(compilerState, sourceBuffer);
+	}
+	logDebugging(_logger, "Parsing the sections...");
+
+	// Each section ends with two NUL characters over the keyword of the next one (which is pushed
+	// instead of scanned), and the last one with the sentinel of the source buffer.
+	char * text = sourceBuffer->text;
+	const size_t end = sourceBuffer->length + SOURCE_BUFFER_SENTINEL_LENGTH;
+	Section sections[3] = {
+		{text, structure.offset + 2, 1, PARSE_OBJECTS, 0, PARSE_STRUCTURE},
+		{text + structure.offset + strlen("Structure"), 0, structure.line, PARSE_STRUCTURE, STRUCTURE, 0},
+		{text + animations.offset + strlen("Animations"), 0, animations.line, PARSE_ANIMATIONS, ANIMATION, 0}
+	};
+	const int sectionCount = animations.found ? 3 : 2;
+	if (animations.found) {
+		sections[1].size = animations.offset + 2 - structure.offset - strlen("Structure");
+		sections[1].nextToken = PARSE_ANIMATIONS;
+		sections[2].size = end - animations.offset - strlen("Animations");
+		memset(text + animations.offset, '\0', 2);
+	}
+	else {
+		sections[1].size = end - structure.offset - strlen("Structure");
+	}
+	memset(text + structure.offset, '\0', 2);
+
+	// Parse the Objects section in this thread, and the rest in their own threads.
+	GThread * threads[3] = {NULL, NULL, NULL};
+	for (int k = 0; k < sectionCount; ++k) {
+		sections[k].compilerState = *compilerState;
+		sections[k].compilerState.abstractSyntaxtTree = NULL;
+		sections[k].compilerState.arena = createArena();
+		sections[k].compilerState.errorCount = 0;
+		sections[k].compilerState.succeed = false;
+		if (0 < k) {
+			threads[k] = g_thread_new("section", _parseSection, &sections[k]);
+		}
+	}
+	_parseSection(&sections[0]);
+
+	// Join the sections into a single tree, in the arena of the compilation.
+	SyntacticAnalysisStatus syntacticAnalysisStatus = ACCEPT;
+	for (int k = 0; k < sectionCount; ++k) {
+		if (0 < k) {
+			g_thread_join(threads[k]);
+		}
+		compilerState->errorCount += sections[k].compilerState.errorCount;
+		mergeArena(compilerState->arena, sections[k].compilerState.arena);
+		if (syntacticAnalysisStatus == ACCEPT) {
+			syntacticAnalysisStatus = sections[k].status;
+		}
+	}
+	Program * program = sections[0].compilerState.abstractSyntaxtTree;
+	Program * structurePart = sections[1].compilerState.abstractSyntaxtTree;
+	Program * animationsPart = animations.found ? sections[2].compilerState.abstractSyntaxtTree : NULL;
+	if (syntacticAnalysisStatus == ACCEPT) {
+		program->structure_definitions = structurePart->structure_definitions;
+		if (animationsPart != NULL) {
+			program->animation_definitions = animationsPart->animation_definitions;
+		}
+	}
+	else {
+		program = NULL;
+	}
+	compilerState->abstractSyntaxtTree = program;
+	compilerState->succeed = (syntacticAnalysisStatus == ACCEPT);
+	logDebugging(_logger, "Parsing the sections is done.");
+	return syntacticAnalysisStatus;
+}
+
+SyntacticAnalysisStatus parseStream(CompilerState * compilerState, FILE * stream) {
+	logDebugging(_logger, "Parsing the stream...");
+	LexicalAnalyzerContext lexicalAnalyzerContext = {
+		.compilerState = compilerState,
+		.streaming = true
+	};
+	yyscan_t scanner;
+	if (yylex_init_extra(&lexicalAnalyzerContext, &scanner) != 0) {
+		logError(_logger, "Flex cannot create a scanner.");
+		return OUT_OF_MEMORY;
+	}
+	yyset_in(stream, scanner);
+	yypstate * parserState = yypstate_new();
+	if (parserState == NULL) {
+		logError(_logger, "Bison cannot create a push-parser.");
+		yylex_destroy(scanner);
+		return OUT_OF_MEMORY;
+	}
+	union SemanticValue semanticValue;
+	int code;
+	do {
+		const int token = yylex(&semanticValue, scanner);
+		code = yypush_parse(parserState, token, &semanticValue, scanner, compilerState);
+	} while (code == YYPUSH_MORE);
+	yypstate_delete(parserState);
+	return _finishParsing(compilerState, scanner, code);
+}
@@ -3,11 +3,15 @@
 
 #include "../../shared/CompilerState.h"
 #include "../../shared/Logger.h"
+#include "../lexical-analysis/LexicalAnalyzerContext.h"
+#include "../lexical-analysis/SourceBuffer.h"
 
 /** Bison imported functions. */
 
-int yylex(void);
-void yyerror(const char * string);
+union SemanticValue;
+
+int yylex(union SemanticValue * semanticValue, yyscan_t scanner);
+void yyerror(yyscan_t scanner, CompilerState * compilerState, const char * string);
 
 /** Initialize module's internal state. */
 void initializeSyntacticAnalyzerModule();
@@ -22,16 +26,27 @@ typedef enum {
 	UNKNOWN_ERROR
 } SyntacticAnalysisStatus;
 
-/**
- * Retrieves the current compiler state. The state must be accessed during the
- * parsing phase (i.e., during a call to the "parse" function). Outside of the
- * parse, the state is set to NULL.
- */
-CompilerState * currentCompilerState();
+/*
+* Executes the parsing phase of the compiler, scanning the source in place.
+* Every call works with its own scanner and parser, so many compilations can
+* be parsed at the same time (as long as each one has its own state).
+*/
+SyntacticAnalysisStatus parse(CompilerState * compilerState, SourceBuffer * sourceBuffer);
+
+/*
+* Executes the parsing phase of the compiler with a thread per section: a
+* pre-scan finds where the Objects, Structure and Animations sections begin,
+* and each one is scanned and parsed on its own (in place too). The checks
+* that cross sections run after the join (see "analyzeSemantics"). If the
+* program can't be split, it's parsed as a whole.
+*/
+SyntacticAnalysisStatus parseSections(CompilerState * compilerState, SourceBuffer * sourceBuffer);
 
 /*
-* Executes the parsing phase of the compiler.
+* Executes the parsing phase of the compiler over a stream (e.g., a pipe or a
+* socket), as it arrives: each token is pushed to the parser as soon as it's
+* scanned, so the source is never held as a whole.
 */
-SyntacticAnalysisStatus parse(CompilerState * compilerState);
+SyntacticAnalysisStatus parseStream(CompilerState * compilerState, FILE * stream);
 
 #endif
@@ -0,0 +1,130 @@
+#include "Arena.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+
+void initializeArenaModule() { _logger = createLogger("Arena"); }
+
+void shutdownArenaModule() {
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+    }
+}
+
+/* PRIVATE FUNCTIONS */
+
+static size_t _align(const size_t size) {
+    return (size + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1);
+}
+
+/**
+ * The first usable byte of a chunk, right after its header.
+ */
+static char *_chunkData(ArenaChunk *chunk) { return (char *)chunk + _align(sizeof(ArenaChunk)); }
+
+static ArenaChunk *_createChunk(const size_t size) {
+    ArenaChunk *chunk = calloc(1, _align(sizeof(ArenaChunk)) + size);
+    chunk->size = size;
+    return chunk;
+}
+
+/* PUBLIC FUNCTIONS */
+
+Arena *createArena() { return calloc(1, sizeof(Arena)); }
+
+void *allocateInArena(Arena *arena, size_t size) {
+    size = _align(size);
+    arena->allocated += size;
+    ArenaChunk *chunk = arena->chunk;
+    if (chunk != NULL && chunk->used + size <= chunk->size) {
+        void *block = _chunkData(chunk) + chunk->used;
+        chunk->used += size;
+        return block;
+    }
+    if (chunk != NULL && ARENA_CHUNK_SIZE / 4 < size) {
+        // A big block gets a chunk of its own, behind the one in use (which isn't full yet)
+        ArenaChunk *bigChunk = _createChunk(size);
+        bigChunk->used = size;
+        bigChunk->previous = chunk->previous;
+        chunk->previous = bigChunk;
+        return _chunkData(bigChunk);
+    }
+    chunk = _createChunk((ARENA_CHUNK_SIZE < size) ? size : ARENA_CHUNK_SIZE);
+    chunk->used = size;
+    chunk->previous = arena->chunk;
+    arena->chunk = chunk;
+    return _chunkData(chunk);
+}
+
+ArenaArray *createArenaArray(Arena *arena, guint elementSize) {
+    ArenaArray *array = allocateInArena(arena, sizeof(ArenaArray));
+    array->arena = arena;
+    array->elementSize = elementSize;
+    return array;
+}
+
+ArenaArray *appendToArenaArray(ArenaArray *array, const void *element) {
+    if (array->len == array->capacity) {
+        const guint capacity = (array->capacity == 0) ? 4 : 2 * array->capacity;
+        const size_t size = _align((size_t)array->capacity * array->elementSize);
+        const size_t extra = _align((size_t)capacity * array->elementSize) - size;
+        ArenaChunk *chunk = array->arena->chunk;
+        if (array->data != NULL && chunk != NULL && (char *)array->data + size == _chunkData(chunk) + chunk->used &&
+            chunk->used + extra <= chunk->size) {
+            chunk->used += extra;
+            array->arena->allocated += extra;
+        } else {
+            void *data = allocateInArena(array->arena, (size_t)capacity * array->elementSize);
+            if (array->len != 0) {
+                memcpy(data, array->data, (size_t)array->len * array->elementSize);
+            }
+            array->data = data;
+        }
+        array->capacity = capacity;
+    }
+    memcpy((char *)array->data + (size_t)array->len * array->elementSize, element,
+           array->elementSize);
+    array->len++;
+    return array;
+}
+
+void mergeArena(Arena *arena, Arena *other) {
+    if (other->chunk != NULL) {
+        ArenaChunk *oldest = other->chunk;
+        while (oldest->previous != NULL) {
+            oldest = oldest->previous;
+        }
+        if (arena->chunk == NULL) {
+            arena->chunk = other->chunk;
+        } else {
+            oldest->previous = arena->chunk->previous;
+            arena->chunk->previous = other->chunk;
+        }
+    }
+    arena->allocated += other->allocated;
+    other->chunk = NULL;
+    other->allocated = 0;
+    other->nextMerged = arena->merged;
+    arena->merged = other;
+}
+
+void destroyArena(Arena *arena) {
+    logDebugging(_logger, "Executing destructor: %s", __FUNCTION__);
+    if (arena != NULL) {
+        logDebugging(_logger, "Releasing %zu bytes of the arena", arena->allocated);
+        ArenaChunk *chunk = arena->chunk;
+        while (chunk != NULL) {
+            ArenaChunk *previous = chunk->previous;
+            free(chunk);
+            chunk = previous;
+        }
+        Arena *merged = arena->merged;
+        while (merged != NULL) {
+            Arena *nextMerged = merged->nextMerged;
+            destroyArena(merged);
+            merged = nextMerged;
+        }
+        free(arena);
+    }
+}
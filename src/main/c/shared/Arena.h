@@ -0,0 +1,96 @@
+#ifndef ARENA_HEADER
+#define ARENA_HEADER
+
+#include "Logger.h"
+#include <glib.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A bump allocator. Memory is taken from big chunks, one piece after the
+ * other, and it's never released piece by piece: the whole arena is released
+ * at once, no matter how many allocations it served.
+ *
+ * Every node of the AST lives in the arena of its compilation, so releasing
+ * a tree is a single call that doesn't depend on its size or its depth.
+ *
+ * An arena isn't thread-safe: each thread allocates from an arena of its own,
+ * and the arenas can be merged once the threads are done (see "mergeArena").
+ */
+#define ARENA_CHUNK_SIZE (64 * 1024)
+#define ARENA_ALIGNMENT 16
+
+typedef struct ArenaChunk {
+    struct ArenaChunk *previous; // The chunk that was full before this one
+    size_t size;                 // Usable bytes, after the header
+    size_t used;
+} ArenaChunk;
+
+typedef struct Arena {
+    ArenaChunk *chunk;        // The chunk in use, linked to every previous one
+    size_t allocated;         // Bytes served so far
+    struct Arena *merged;     // The last arena merged into this one, linked to every previous one
+    struct Arena *nextMerged; // The arena merged before this one into the same arena
+} Arena;
+
+/**
+ * A growable array in an arena. When it's full, its elements move to a block
+ * twice as big, and the old block is left behind (so it wastes as much memory
+ * as the array holds, at most), unless the block is the last one served by
+ * the arena, which just grows in place.
+ *
+ * An array must not grow once its arena is merged into another one (see
+ * "mergeArena"): its elements stay valid, but they're no longer where the
+ * arena serves blocks, so every append would move them.
+ */
+typedef struct {
+    Arena *arena;
+    void *data;
+    guint len;
+    guint capacity;
+    guint elementSize;
+} ArenaArray;
+
+#define arenaArrayIndex(array, type, index) (((type *)(array)->data)[(index)])
+
+/** Initialize module's internal state. */
+void initializeArenaModule();
+
+/** Shutdown module's internal state. */
+void shutdownArenaModule();
+
+/**
+ * Creates an empty arena.
+ */
+Arena *createArena();
+
+/**
+ * Allocates a block of the given size, filled with zeros. It's owned by the
+ * arena: it must not be freed.
+ */
+void *allocateInArena(Arena *arena, size_t size);
+
+/**
+ * Creates an empty array of elements of the given size.
+ */
+ArenaArray *createArenaArray(Arena *arena, guint elementSize);
+
+/**
+ * Appends a copy of the element at the end of the array.
+ */
+ArenaArray *appendToArenaArray(ArenaArray *array, const void *element);
+
+/**
+ * Moves every chunk of the other arena into the arena (the blocks it served
+ * stay valid until the arena gets destroyed). The other arena is left empty,
+ * but it isn't released until the arena gets destroyed, since the arrays it
+ * served still point at it.
+ */
+void mergeArena(Arena *arena, Arena *other);
+
+/**
+ * Destroys the arena, releasing every block it served.
+ */
+void destroyArena(Arena *arena);
+
+#endif
@@ -1,32 +1,52 @@
 #ifndef COMPILER_STATE_HEADER
 #define COMPILER_STATE_HEADER
 
+#include "Arena.h"
+#include "OutputSink.h"
+#include "StringPool.h"
 #include "SymbolTable.h"
 #include "Type.h"
+#include <stdio.h>
 /**
  * The general status of a compilation.
  */
 typedef enum { SUCCEED = 0, FAILED = 1 } CompilationStatus;
 /**
- * The global state of the compiler. Should transport every data structure
- * needed across the different phases of a compilation.
+ * The state of a single compilation. Should transport every data structure
+ * needed across the different phases of a compilation: no phase keeps state
+ * of its own, so many compilations can run at the same time.
  */
 typedef struct {
     // The root node of the AST.
     void *abstractSyntaxtTree;
 
+    // Owns every node of the AST
+    Arena *arena;
+
     // A flag that indicates the current state of the compilation so far.
     boolean succeed;
 
-    int errorCount;   // track errors during syntactic analysis
+    int errorCount;   // track errors during semantic analysis
     int slideCounter; // "scope" counter
 
     SymbolTable *symbolTable;
 
+    // Atoms of every identifier, property name and property value
+    StringPool *stringPool;
+
     // Array of slides for div generation, Domain specific
     // One slot for each slide
     SlideList *slides;
 
+    // Directory of the generated presentation, and its file name without extension (the
+    // presentation identifier, if NULL)
+    const char *outputDirectory;
+    const char *outputName;
+
+    // Where the presentation is generated: a sink of the caller (e.g., the standard output, or
+    // memory), or NULL for a file in the output directory, only while the code-generation runs
+    OutputSink *output;
+
 } CompilerState;
 
 #endif
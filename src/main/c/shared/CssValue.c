@@ -0,0 +1,173 @@
+#include "CssValue.h"
+
+/* MODULE INTERNAL STATE */
+
+// Indexed by LengthUnit.
+static const char *const _unitNames[] = {"ch", "cm", "em", "ex", "in",  "mm",   "pc",
+                                         "pt", "px", "rem", "vh", "vmax", "vmin", "vw"};
+static const int _unitCount = sizeof(_unitNames) / sizeof(_unitNames[0]);
+
+// More digits could overflow the 64 bits of a length.
+static const int _maximumDigits = 18;
+
+static const char _hexadecimalDigits[] = "0123456789abcdef";
+
+/* PRIVATE FUNCTIONS */
+
+static int _hexadecimalValue(const char character);
+static boolean _parseChannel(const char **cursor, const char *end, uint32_t *channel);
+static boolean _parseSeparator(const char **cursor, const char *end, const char separator);
+
+/* Returns the value of an hexadecimal digit, or -1 if it isn't one */
+static int _hexadecimalValue(const char character) {
+    if ('0' <= character && character <= '9') {
+        return character - '0';
+    }
+    const char lowercase = tolower((unsigned char)character);
+    if ('a' <= lowercase && lowercase <= 'f') {
+        return lowercase - 'a' + 10;
+    }
+    return -1;
+}
+
+/* Parses a channel of an "rgb(...)" color, in [0, 255], along with the blanks around it */
+static boolean _parseChannel(const char **cursor, const char *end, uint32_t *channel) {
+    const char *current = *cursor;
+    while (current < end && isspace((unsigned char)*current)) {
+        ++current;
+    }
+    uint32_t value = 0;
+    int digits = 0;
+    while (current < end && isdigit((unsigned char)*current) && digits < 3) {
+        value = 10 * value + (*current - '0');
+        ++current;
+        ++digits;
+    }
+    while (current < end && isspace((unsigned char)*current)) {
+        ++current;
+    }
+    if (digits == 0 || 255 < value) {
+        return false;
+    }
+    *cursor = current;
+    *channel = value;
+    return true;
+}
+
+static boolean _parseSeparator(const char **cursor, const char *end, const char separator) {
+    if (*cursor < end && **cursor == separator) {
+        ++*cursor;
+        return true;
+    }
+    return false;
+}
+
+/* PUBLIC FUNCTIONS */
+
+boolean parseLength(const char *text, const int length, Length *result) {
+    int64_t digits = 0;
+    int count = 0;
+    int decimals = 0;
+    boolean fraction = false;
+    int k = 0;
+    for (; k < length; ++k) {
+        if (text[k] == '.' && !fraction) {
+            fraction = true;
+            continue;
+        }
+        if (!isdigit((unsigned char)text[k])) {
+            break;
+        }
+        if (_maximumDigits < ++count) {
+            return false;
+        }
+        digits = 10 * digits + (text[k] - '0');
+        if (fraction) {
+            ++decimals;
+        }
+    }
+    if (count == 0 || (fraction && decimals == 0)) {
+        return false;
+    }
+    const int unitLength = length - k;
+    for (int unit = 0; unit < _unitCount; ++unit) {
+        if (strlen(_unitNames[unit]) == unitLength &&
+            strncasecmp(_unitNames[unit], text + k, unitLength) == 0) {
+            *result = (Length){digits, decimals, unit};
+            return true;
+        }
+    }
+    return false;
+}
+
+boolean parseColor(const char *text, const int length, Color *result) {
+    if (0 < length && text[0] == '#') {
+        const int count = length - 1;
+        if (count != 3 && count != 4 && count != 6 && count != 8) {
+            return false;
+        }
+        Color color = 0;
+        for (int k = 1; k <= count; ++k) {
+            const int nibble = _hexadecimalValue(text[k]);
+            if (nibble < 0) {
+                return false;
+            }
+            // In the short forms, every digit stands for a whole channel ("#abc" is "#aabbcc")
+            color = (count <= 4) ? (color << 8) | (nibble * 0x11) : (color << 4) | nibble;
+        }
+        if (count == 3 || count == 6) {
+            color = (color << 8) | 0xff;
+        }
+        *result = color;
+        return true;
+    }
+    if (5 < length && strncasecmp(text, "rgb(", 4) == 0 && text[length - 1] == ')') {
+        const char *cursor = text + 4;
+        const char *end = text + length - 1;
+        uint32_t red, green, blue;
+        if (_parseChannel(&cursor, end, &red) && _parseSeparator(&cursor, end, ',') &&
+            _parseChannel(&cursor, end, &green) && _parseSeparator(&cursor, end, ',') &&
+            _parseChannel(&cursor, end, &blue) && cursor == end) {
+            *result = (red << 24) | (green << 16) | (blue << 8) | 0xff;
+            return true;
+        }
+    }
+    return false;
+}
+
+int formatLength(const Length length, char *buffer) {
+    // The digits come out backwards, with at least one before the decimal point
+    char digits[CSS_VALUE_BUFFER_SIZE];
+    int count = 0;
+    int64_t value = length.digits;
+    do {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (0 < value || count <= length.decimals);
+
+    int written = 0;
+    while (0 < count) {
+        if (count == length.decimals) {
+            buffer[written++] = '.';
+        }
+        buffer[written++] = digits[--count];
+    }
+    for (const char *unit = _unitNames[length.unit]; *unit != '\0'; ++unit) {
+        buffer[written++] = *unit;
+    }
+    buffer[written] = '\0';
+    return written;
+}
+
+int formatColor(const Color color, char *buffer) {
+    const int channels = ((color & 0xff) == 0xff) ? 3 : 4;
+    int written = 0;
+    buffer[written++] = '#';
+    for (int k = 0; k < channels; ++k) {
+        const uint32_t channel = (color >> (24 - 8 * k)) & 0xff;
+        buffer[written++] = _hexadecimalDigits[channel >> 4];
+        buffer[written++] = _hexadecimalDigits[channel & 0x0f];
+    }
+    buffer[written] = '\0';
+    return written;
+}
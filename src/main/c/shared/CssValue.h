@@ -0,0 +1,44 @@
+#ifndef CSS_VALUE_HEADER
+#define CSS_VALUE_HEADER
+
+#include "Type.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Typed CSS values. Lengths and colors are parsed once, when the lexeme gets scanned, and then
+ * formatted straight into a caller buffer (no heap-memory involved).
+ */
+
+/** Enough room for any formatted length or color, including the NUL character. */
+#define CSS_VALUE_BUFFER_SIZE 32
+
+/**
+ * Parses a length such as "12px" or "1.5em" (the unit is case-insensitive).
+ * @return False if the unit is unknown or the number is too long, so the lexeme can be kept as a
+ * keyword.
+ */
+boolean parseLength(const char *text, const int length, Length *result);
+
+/**
+ * Parses a color written as "#rgb", "#rgba", "#rrggbb", "#rrggbbaa" or "rgb(r, g, b)".
+ * @return False if the color is malformed, so the lexeme can be kept as a keyword.
+ */
+boolean parseColor(const char *text, const int length, Color *result);
+
+/**
+ * Writes the length into a buffer of CSS_VALUE_BUFFER_SIZE characters, with the digits as
+ * written and the unit in lowercase.
+ * @return The length of the formatted value.
+ */
+int formatLength(const Length length, char *buffer);
+
+/**
+ * Writes the color into a buffer of CSS_VALUE_BUFFER_SIZE characters, normalized to lowercase
+ * "#rrggbb" (or "#rrggbbaa", if it isn't opaque).
+ * @return The length of the formatted value.
+ */
+int formatColor(const Color color, char *buffer);
+
+#endif
@@ -15,8 +15,7 @@ static const char * _toContextString(const LoggingLevel loggingLevel);
  * Logs a new message at the specified level, using a format string.
  */
 static void _log(const Logger * logger, const LoggingLevel loggingLevel, const char * const format, va_list arguments) {
-	LoggingLevel effectiveLevel = USE_GLOBAL_LOGGING_LEVEL ? GLOBAL_LOGGING_LEVEL : logger->loggingLevel;
-	if (effectiveLevel <= loggingLevel) {
+	if (isLoggingEnabled(logger, loggingLevel)) {
 		const char * context = _toContextString(loggingLevel);
 		char * effectiveFormat = concatenate(6, context, "[", logger->name, "] ", format, "\n");
 		if (ERROR <= loggingLevel) {
@@ -95,6 +94,11 @@ void setGlobalLoggingLevel(LoggingLevel level) {
 	USE_GLOBAL_LOGGING_LEVEL = true;
 }
 
+boolean isLoggingEnabled(const Logger * logger, const LoggingLevel loggingLevel) {
+	LoggingLevel effectiveLevel = USE_GLOBAL_LOGGING_LEVEL ? GLOBAL_LOGGING_LEVEL : logger->loggingLevel;
+	return effectiveLevel <= loggingLevel;
+}
+
 void destroyLogger(Logger * logger) {
 	if (logger != NULL) {
 		if (logger->name != NULL) {
@@ -104,35 +108,35 @@ void destroyLogger(Logger * logger) {
 	}
 }
 
-void logCritical(const Logger * logger, const char * const format, ...) {
+void (logCritical)(const Logger * logger, const char * const format, ...) {
 	va_list arguments;
 	va_start(arguments, format);
 	_log(logger, CRITICAL, format, arguments);
 	va_end(arguments);
 }
 
-void logDebugging(const Logger * logger, const char * const format, ...) {
+void (logDebugging)(const Logger * logger, const char * const format, ...) {
 	va_list arguments;
 	va_start(arguments, format);
 	_log(logger, DEBUGGING, format, arguments);
 	va_end(arguments);
 }
 
-void logError(const Logger * logger, const char * const format, ...) {
+void (logError)(const Logger * logger, const char * const format, ...) {
 	va_list arguments;
 	va_start(arguments, format);
 	_log(logger, ERROR, format, arguments);
 	va_end(arguments);
 }
 
-void logInformation(const Logger * logger, const char * const format, ...) {
+void (logInformation)(const Logger * logger, const char * const format, ...) {
 	va_list arguments;
 	va_start(arguments, format);
 	_log(logger, INFORMATION, format, arguments);
 	va_end(arguments);
 }
 
-void logWarning(const Logger * logger, const char * const format, ...) {
+void (logWarning)(const Logger * logger, const char * const format, ...) {
 	va_list arguments;
 	va_start(arguments, format);
 	_log(logger, WARNING, format, arguments);
@@ -63,9 +63,22 @@ typedef enum {
 	INFORMATION = 20,
 	WARNING = 30,
 	ERROR = 40,
-	CRITICAL = 50
+	CRITICAL = 50,
+	OFF = 60
 } LoggingLevel;
 
+/**
+ * The minimum logging level compiled into the binary. Every log below it
+ * checks a condition that is constant false, so the optimizer folds the log
+ * away, arguments included, and it costs nothing at runtime (without
+ * optimizations, the check and the call stay in the binary). Use INFORMATION
+ * to drop every DEBUGGING trace, or OFF to drop all the logs (see the
+ * COMPILED_LOGGING_LEVEL option in CMake).
+ */
+#ifndef COMPILED_LOGGING_LEVEL
+#define COMPILED_LOGGING_LEVEL ALL
+#endif
+
 /**
  * The definition of a logger. It contains a name to see its traces, and a
  * logging level that defines when the logs must be visible.
@@ -90,6 +103,12 @@ Logger * createLoggerLevelSpecified(char * name, LoggingLevel loggingLevel);
  */
 void destroyLogger(Logger * logger);
 
+/**
+ * Returns true if the logger would print a message at the specified level.
+ * Check it before building an expensive message (e.g., escaping a string).
+ */
+boolean isLoggingEnabled(const Logger * logger, const LoggingLevel loggingLevel);
+
 /** Logs at CRITICAL level. */
 void logCritical(const Logger * logger, const char * const format, ...);
 
@@ -105,6 +124,29 @@ void logInformation(const Logger * logger, const char * const format, ...);
 /** Logs at WARNING level. */
 void logWarning(const Logger * logger, const char * const format, ...);
 
+/**
+ * Same as "isLoggingEnabled", but constant-folded to false when the level is
+ * not compiled into the binary.
+ */
+#define shouldLog(logger, loggingLevel) \
+	((loggingLevel) >= COMPILED_LOGGING_LEVEL && isLoggingEnabled((logger), (loggingLevel)))
+
+/**
+ * Level-checked logging: the arguments (and the formatting) are only
+ * evaluated if the message is going to be printed.
+ */
+#define _logIfEnabled(function, loggingLevel, logger, ...) \
+	do { \
+		if (shouldLog((logger), (loggingLevel))) { \
+			(function)((logger), __VA_ARGS__); \
+		} \
+	} while (0)
+
+#define logCritical(logger, ...) _logIfEnabled(logCritical, CRITICAL, logger, __VA_ARGS__)
+#define logDebugging(logger, ...) _logIfEnabled(logDebugging, DEBUGGING, logger, __VA_ARGS__)
+#define logError(logger, ...) _logIfEnabled(logError, ERROR, logger, __VA_ARGS__)
+#define logInformation(logger, ...) _logIfEnabled(logInformation, INFORMATION, logger, __VA_ARGS__)
+#define logWarning(logger, ...) _logIfEnabled(logWarning, WARNING, logger, __VA_ARGS__)
 
 void setGlobalLoggingLevel(LoggingLevel level);
 
@@ -0,0 +1,192 @@
+#include "OutputSink.h"
+#include <stdarg.h>
+#include <stdint.h>
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+
+void initializeOutputSinkModule() { _logger = createLogger("OutputSink"); }
+
+void shutdownOutputSinkModule() {
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+    }
+}
+
+/* PRIVATE FUNCTIONS */
+
+static OutputSink *_createSink(FILE *stream, const boolean closeStream, const size_t flushSize,
+                               const size_t capacity) {
+    OutputSink *sink = calloc(1, sizeof(OutputSink));
+    initializeStringBuilder(&sink->buffer, capacity);
+    sink->stream = stream;
+    sink->closeStream = closeStream;
+    sink->flushSize = flushSize;
+    return sink;
+}
+
+/**
+ * Writes the whole buffer to the stream, and empties it.
+ */
+static void _flush(OutputSink *sink) {
+    StringBuilder *buffer = &sink->buffer;
+    if (buffer->length == 0) {
+        return;
+    }
+    if (fwrite(buffer->data, 1, buffer->length, sink->stream) != buffer->length && !sink->failed) {
+        logError(_logger, "Cannot write the output (%zu bytes written so far).", sink->written);
+        sink->failed = true;
+    }
+    sink->written += buffer->length;
+    buffer->length = 0;
+}
+
+/**
+ * Makes room for "length" more bytes: a sink that writes as it goes is flushed
+ * first, and the buffer doubles its size until they fit.
+ */
+static void _reserve(OutputSink *sink, const size_t length) {
+    if (sink->stream != NULL && sink->flushSize <= sink->buffer.length + length) {
+        _flush(sink);
+    }
+    reserveStringBuilder(&sink->buffer, length);
+}
+
+/* PUBLIC FUNCTIONS */
+
+OutputSink *createFileSink(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        logError(_logger, "Cannot open the output file \"%s\" for writing.", path);
+        return NULL;
+    }
+    return _createSink(file, true, OUTPUT_SINK_FLUSH_SIZE, OUTPUT_SINK_INITIAL_SIZE);
+}
+
+OutputSink *createStreamSink(FILE *stream) {
+    return _createSink(stream, false, SIZE_MAX, OUTPUT_SINK_INITIAL_SIZE);
+}
+
+OutputSink *createMemorySink() {
+    return _createSink(NULL, false, SIZE_MAX, OUTPUT_SINK_MEMORY_SIZE);
+}
+
+void writeToSink(OutputSink *sink, const char *bytes, const size_t length) {
+    // An empty run may come with a NULL pointer, which memcpy must not get
+    if (length == 0) {
+        return;
+    }
+    StringBuilder *buffer = &sink->buffer;
+    if (buffer->capacity < buffer->length + length ||
+        (sink->stream != NULL && sink->flushSize <= buffer->length + length)) {
+        _reserve(sink, length);
+    }
+    memcpy(buffer->data + buffer->length, bytes, length);
+    buffer->length += length;
+}
+
+void writeString(OutputSink *sink, const char *string) {
+    writeToSink(sink, string, strlen(string));
+}
+
+void writeCharacter(OutputSink *sink, const char character) {
+    StringBuilder *buffer = &sink->buffer;
+    if (buffer->length == buffer->capacity) {
+        _reserve(sink, 1);
+    }
+    buffer->data[buffer->length++] = character;
+}
+
+void writeInteger(OutputSink *sink, const long long integer) {
+    // The digits are written backwards, from the least significant one
+    char digits[24];
+    char *digit = digits + sizeof(digits);
+    unsigned long long magnitude = (integer < 0) ? -(unsigned long long)integer : integer;
+    do {
+        *--digit = '0' + (magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (integer < 0) {
+        *--digit = '-';
+    }
+    writeToSink(sink, digit, digits + sizeof(digits) - digit);
+}
+
+void writeEscaped(OutputSink *sink, const char *bytes, const size_t length) {
+    // The runs of bytes that don't need escaping are copied at once
+    size_t start = 0;
+    for (size_t k = 0; k < length; ++k) {
+        const char *reference;
+        switch (bytes[k]) {
+        case '&':
+            reference = "&amp;";
+            break;
+        case '<':
+            reference = "&lt;";
+            break;
+        case '>':
+            reference = "&gt;";
+            break;
+        case '\'':
+            reference = "&#39;";
+            break;
+        case '"':
+            reference = "&quot;";
+            break;
+        default:
+            continue;
+        }
+        writeToSink(sink, bytes + start, k - start);
+        writeString(sink, reference);
+        start = k + 1;
+    }
+    writeToSink(sink, bytes + start, length - start);
+}
+
+void writeFormatted(OutputSink *sink, const char *format, ...) {
+    va_list arguments;
+    va_start(arguments, format);
+    va_list copy;
+    va_copy(copy, arguments);
+    const int length = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    if (0 < length) {
+        // One more byte for the null-terminator, which isn't kept
+        _reserve(sink, length + 1);
+        vsnprintf(sink->buffer.data + sink->buffer.length, length + 1, format, arguments);
+        sink->buffer.length += length;
+    }
+    va_end(arguments);
+}
+
+const char *sinkContents(OutputSink *sink, size_t *length) {
+    *length = sink->buffer.length;
+    return sink->buffer.data;
+}
+
+char *sinkToString(OutputSink *sink) {
+    char *string = builderToString(&sink->buffer);
+    free(sink);
+    return string;
+}
+
+boolean destroySink(OutputSink *sink) {
+    if (sink == NULL) {
+        return true;
+    }
+    if (sink->stream != NULL) {
+        _flush(sink);
+        if (fflush(sink->stream) != 0) {
+            sink->failed = true;
+        }
+        if (sink->closeStream && fclose(sink->stream) != 0) {
+            sink->failed = true;
+        }
+        logDebugging(_logger, "Output written (%zu bytes).", sink->written);
+    }
+    const boolean succeed = !sink->failed;
+    destroyStringBuilder(&sink->buffer);
+    free(sink);
+    return succeed;
+}
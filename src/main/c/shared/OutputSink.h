@@ -0,0 +1,119 @@
+#ifndef OUTPUT_SINK_HEADER
+#define OUTPUT_SINK_HEADER
+
+#include "Logger.h"
+#include "StringBuilder.h"
+#include "Type.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A growable byte buffer for the generated output. Every append is a copy
+ * into the buffer (no format string is parsed, except by "writeFormatted"),
+ * and the buffer reaches its destination in a few big writes:
+ *
+ *   - a file sink writes the buffer every time it holds OUTPUT_SINK_FLUSH_SIZE
+ *     bytes, and once more when it's destroyed,
+ *   - a stream sink (e.g., the standard output) keeps the whole output, and
+ *     writes it at once when it's destroyed, so that the outputs of many
+ *     compilations at the same time don't interleave,
+ *   - a memory sink keeps the whole output for the caller (see "sinkContents"),
+ *     and never writes it.
+ *
+ * A sink isn't thread-safe: each compilation writes to a sink of its own.
+ */
+#define OUTPUT_SINK_INITIAL_SIZE (64 * 1024)
+#define OUTPUT_SINK_MEMORY_SIZE 256
+#define OUTPUT_SINK_FLUSH_SIZE (1024 * 1024)
+
+typedef struct {
+    StringBuilder buffer; // What's not written to the stream yet (or all of it, for a memory sink)
+    FILE *stream;         // Where the output is written, or NULL for a memory sink
+    boolean closeStream;  // Whether the stream belongs to the sink (i.e., it's a file)
+    size_t flushSize;     // The length that triggers a write (SIZE_MAX to write only at the end)
+    size_t written;       // Bytes written to the stream so far
+    boolean failed;       // Whether a write to the stream failed
+} OutputSink;
+
+/** Initialize module's internal state. */
+void initializeOutputSinkModule();
+
+/** Shutdown module's internal state. */
+void shutdownOutputSinkModule();
+
+/**
+ * Creates a sink that writes to a new file at the path (it's overwritten, if
+ * it exists). Returns NULL if the file cannot be opened for writing.
+ */
+OutputSink *createFileSink(const char *path);
+
+/**
+ * Creates a sink that writes to an open stream (e.g., "stdout"), which is
+ * flushed but never closed by the sink.
+ */
+OutputSink *createStreamSink(FILE *stream);
+
+/**
+ * Creates a sink that keeps its output in memory. It starts small (with
+ * OUTPUT_SINK_MEMORY_SIZE bytes), and grows as a string builder does.
+ */
+OutputSink *createMemorySink();
+
+/**
+ * Appends the bytes to the sink. The bytes may be NULL when the length is 0.
+ */
+void writeToSink(OutputSink *sink, const char *bytes, const size_t length);
+
+/**
+ * Appends a string literal, with its length known at compile time.
+ */
+#define writeLiteral(sink, literal) writeToSink((sink), (literal), sizeof(literal) - 1)
+
+/**
+ * Appends a null-terminated string.
+ */
+void writeString(OutputSink *sink, const char *string);
+
+/**
+ * Appends a single character.
+ */
+void writeCharacter(OutputSink *sink, const char character);
+
+/**
+ * Appends an integer, in decimal.
+ */
+void writeInteger(OutputSink *sink, const long long integer);
+
+/**
+ * Appends the bytes escaped for HTML text or for an attribute value (between
+ * single or double quotes): "&", "<", ">", "'" and '"' are replaced by their
+ * character references.
+ */
+void writeEscaped(OutputSink *sink, const char *bytes, const size_t length);
+
+/**
+ * Appends a formatted string, as "printf" does. Only for the odd case that
+ * the other appends don't cover.
+ */
+void writeFormatted(OutputSink *sink, const char *format, ...);
+
+/**
+ * The output kept by a memory sink so far (not null-terminated), and its
+ * length. It belongs to the sink.
+ */
+const char *sinkContents(OutputSink *sink, size_t *length);
+
+/**
+ * Destroys a memory sink, and returns its output as a null-terminated string
+ * (using heap-memory, so it must be freed).
+ */
+char *sinkToString(OutputSink *sink);
+
+/**
+ * Writes what's left in the buffer, closes the file (if it's a file sink),
+ * and destroys the sink. Returns whether every write succeeded.
+ */
+boolean destroySink(OutputSink *sink);
+
+#endif
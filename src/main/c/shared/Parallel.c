@@ -0,0 +1,34 @@
+#include "Parallel.h"
+
+/* PRIVATE FUNCTIONS */
+
+static TaskRange *_rangeOf(void *contexts, const size_t stride, const guint worker) {
+    return (TaskRange *)((char *)contexts + worker * stride);
+}
+
+/* PUBLIC FUNCTIONS */
+
+guint countWorkers(guint taskCount, int requestedWorkers, guint minimumTasksPerWorker) {
+    const guint workerCount = (0 < requestedWorkers)
+                                  ? (guint)requestedWorkers
+                                  : MIN((guint)g_get_num_processors(),
+                                        taskCount / minimumTasksPerWorker);
+    return CLAMP(workerCount, 1, MAX(taskCount, 1));
+}
+
+void runRanges(guint taskCount, guint workerCount, GThreadFunc run, void *contexts, size_t stride) {
+    GThread **threads = calloc(workerCount, sizeof(GThread *));
+    for (guint k = 0; k < workerCount; ++k) {
+        TaskRange *range = _rangeOf(contexts, stride, k);
+        range->first = (guint)((guint64)taskCount * k / workerCount);
+        range->last = (guint)((guint64)taskCount * (k + 1) / workerCount);
+        if (0 < k) {
+            threads[k] = g_thread_new("worker", run, range);
+        }
+    }
+    run(_rangeOf(contexts, stride, 0));
+    for (guint k = 1; k < workerCount; ++k) {
+        g_thread_join(threads[k]);
+    }
+    free(threads);
+}
@@ -0,0 +1,42 @@
+#ifndef PARALLEL_HEADER
+#define PARALLEL_HEADER
+
+#include <glib.h>
+#include <stdlib.h>
+
+/**
+ * Runs a list of independent tasks (e.g., the slides of a program) in many
+ * threads. The tasks are split in contiguous ranges, one for each worker, so
+ * each worker sees its tasks in source order, and the results can be merged
+ * in source order once every worker is done.
+ *
+ * The context of each worker starts with its range, which is filled before
+ * the worker runs:
+ *
+ *   typedef struct {
+ *       TaskRange range;
+ *       ...
+ *   } Worker;
+ */
+typedef struct {
+    guint first;
+    guint last; // Exclusive
+} TaskRange;
+
+/**
+ * The number of workers for the tasks: the requested one, if it's positive,
+ * or one for each processor, as long as each one gets at least the minimum
+ * tasks given (fewer tasks don't pay for a thread). It's never more than the
+ * tasks, nor less than one.
+ */
+guint countWorkers(guint taskCount, int requestedWorkers, guint minimumTasksPerWorker);
+
+/**
+ * Splits the tasks in a contiguous range for each worker, and runs each one
+ * in its own thread (the first one in the calling thread), with its context.
+ * The contexts are in an array with the stride given (i.e., the size of each
+ * one). Returns once every worker is done.
+ */
+void runRanges(guint taskCount, guint workerCount, GThreadFunc run, void *contexts, size_t stride);
+
+#endif
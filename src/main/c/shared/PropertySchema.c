@@ -0,0 +1,99 @@
+#include "PropertySchema.h"
+
+/* MODULE INTERNAL STATE */
+
+typedef struct {
+    const char *name;
+    size_t length;
+    unsigned objects; // ON_SLIDE, ON_TEXTBLOCK and ON_IMAGE
+    unsigned values;  // VALUE_KEYWORD, VALUE_INTEGER, ...
+} PropertyDefinition;
+
+#define PROPERTY_DEFINITION(key, name, objects, values)                                            \
+    [key] = {name, sizeof(name) - 1, objects, values},
+static const PropertyDefinition _schema[] = {PROPERTY_SCHEMA(PROPERTY_DEFINITION)};
+#undef PROPERTY_DEFINITION
+
+// With (at least) twice the slots as properties, a few seeds are enough for a perfect hash
+_Static_assert(2 * PROP_UNKNOWN <= PROPERTY_SLOTS, "PROPERTY_SLOTS is too small for the schema");
+_Static_assert((PROPERTY_SLOTS & (PROPERTY_SLOTS - 1)) == 0, "PROPERTY_SLOTS isn't a power of 2");
+
+static Logger *_logger = NULL;
+static guint32 _seed = 0;
+static PropertyKey _slots[PROPERTY_SLOTS];
+
+/* PRIVATE FUNCTIONS */
+
+/**
+ * FNV-1a (Fowler, Noll and Vo), starting from the seed.
+ */
+static guint32 _hash(const guint32 seed, const char *name, const size_t length) {
+    guint32 hash = 2166136261u ^ seed;
+    for (size_t k = 0; k < length; ++k) {
+        hash ^= (unsigned char)name[k];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static guint32 _slot(const guint32 seed, const char *name, const size_t length) {
+    return _hash(seed, name, length) & (PROPERTY_SLOTS - 1);
+}
+
+/**
+ * Fills the slots with the seed, and returns whether each property got a slot of its own.
+ */
+static boolean _tryPerfectHash(const guint32 seed) {
+    for (int k = 0; k < PROPERTY_SLOTS; ++k) {
+        _slots[k] = PROP_UNKNOWN;
+    }
+    for (PropertyKey key = 0; key < PROP_UNKNOWN; ++key) {
+        const guint32 slot = _slot(seed, _schema[key].name, _schema[key].length);
+        if (_slots[slot] != PROP_UNKNOWN) {
+            return false;
+        }
+        _slots[slot] = key;
+    }
+    return true;
+}
+
+/* PUBLIC FUNCTIONS */
+
+void initializePropertySchemaModule() {
+    _logger = createLogger("PropertySchema");
+    for (_seed = 0; !_tryPerfectHash(_seed); ++_seed) {
+    }
+    logDebugging(_logger, "Perfect hash of %d properties in %d slots, with seed %u.", PROP_UNKNOWN,
+                 PROPERTY_SLOTS, _seed);
+}
+
+void shutdownPropertySchemaModule() {
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+    }
+}
+
+PropertyKey getPropertyKey(const char *name) {
+    if (name == NULL) {
+        return PROP_UNKNOWN;
+    }
+    const size_t length = strlen(name);
+    const PropertyKey key = _slots[_slot(_seed, name, length)];
+    if (key != PROP_UNKNOWN && _schema[key].length == length &&
+        memcmp(_schema[key].name, name, length) == 0) {
+        return key;
+    }
+    return PROP_UNKNOWN;
+}
+
+const char *getPropertyName(PropertyKey key) {
+    return (key < PROP_UNKNOWN) ? _schema[key].name : NULL;
+}
+
+boolean isPropertyOf(PropertyKey key, ObjectType type) {
+    return key < PROP_UNKNOWN && (_schema[key].objects & (1u << type)) != 0;
+}
+
+boolean acceptsValue(PropertyKey key, PropertyValueType valueType) {
+    return key < PROP_UNKNOWN && (_schema[key].values & (1u << valueType)) != 0;
+}
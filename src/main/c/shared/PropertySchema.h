@@ -0,0 +1,46 @@
+#ifndef PROPERTY_SCHEMA_HEADER
+#define PROPERTY_SCHEMA_HEADER
+
+#include "Logger.h"
+#include "Type.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Lookup of the properties in the schema (see PROPERTY_SCHEMA in Type.h). The
+ * names are hashed into a table with a slot for each one, with no collisions
+ * (i.e., a perfect hash), so resolving a name costs a single hash and a single
+ * comparison, no matter how many properties there are.
+ *
+ * The seed of the hash is searched when the module is initialized, once for
+ * the whole process, so a new row in the schema needs nothing else.
+ */
+#define PROPERTY_SLOTS 32
+
+/** Initialize module's internal state. */
+void initializePropertySchemaModule();
+
+/** Shutdown module's internal state. */
+void shutdownPropertySchemaModule();
+
+/**
+ * The key of the property with the name, or PROP_UNKNOWN if there is none.
+ */
+PropertyKey getPropertyKey(const char *name);
+
+/**
+ * The name of the property (NULL for PROP_UNKNOWN).
+ */
+const char *getPropertyName(PropertyKey key);
+
+/**
+ * Whether the property applies to the type of object.
+ */
+boolean isPropertyOf(PropertyKey key, ObjectType type);
+
+/**
+ * Whether the property accepts the kind of value.
+ */
+boolean acceptsValue(PropertyKey key, PropertyValueType valueType);
+
+#endif
@@ -1,7 +1,11 @@
 #include "String.h"
+#include "StringBuilder.h"
 
 /* PRIVATE FUNCTIONS */
 
+// The initial capacity of the builders, which double it when they're full
+#define STRING_BUILDER_SIZE 256
+
 static const char * _controlCharacterToEscapedString(const char character);
 
 /**
@@ -51,46 +55,29 @@ static const char * _controlCharacterToEscapedString(const char character) {
 /* PUBLIC FUNCTIONS */
 
 char * concatenate(const unsigned int count, ...) {
+	StringBuilder string;
+	initializeStringBuilder(&string, STRING_BUILDER_SIZE);
 	va_list arguments;
 	va_start(arguments, count);
-	unsigned int length = 1;
-	for (unsigned int k = 0; k < count; ++k) {
-		const char * nextString = va_arg(arguments, const char *);
-		length += strlen(nextString);
-	}
-	va_end(arguments);
-	char * string = calloc(length, sizeof(char));
-	va_start(arguments, count);
 	for (unsigned int k = 0; k < count; ++k) {
-		const char * nextString = va_arg(arguments, const char *);
-		strcat(string, nextString);
+		appendString(&string, va_arg(arguments, const char *));
 	}
 	va_end(arguments);
-	return string;
+	return builderToString(&string);
 }
 
 char * escape(const char * string) {
-	unsigned int length = 1;
-	for (unsigned int k = 0; 0 < string[k]; ++k) {
-		if (iscntrl(string[k])) {
-			length += strlen(_controlCharacterToEscapedString(string[k]));
-		}
-		else {
-			length += 1;
-		}
-	}
-	char * escapedString = calloc(length, sizeof(char));
-	char charToString[2] = { 0, 0 };
+	StringBuilder escapedString;
+	initializeStringBuilder(&escapedString, STRING_BUILDER_SIZE);
 	for (unsigned int k = 0; 0 < string[k]; ++k) {
 		if (iscntrl(string[k])) {
-			strcat(escapedString, _controlCharacterToEscapedString(string[k]));
+			appendString(&escapedString, _controlCharacterToEscapedString(string[k]));
 		}
 		else {
-			charToString[0] = string[k];
-			strcat(escapedString, charToString);
+			appendCharacter(&escapedString, string[k]);
 		}
 	}
-	return escapedString;
+	return builderToString(&escapedString);
 }
 
 char * indentation(const char character, const unsigned int level, const unsigned int size) {
@@ -0,0 +1,57 @@
+#include "StringBuilder.h"
+
+/* PUBLIC FUNCTIONS */
+
+void initializeStringBuilder(StringBuilder *builder, const size_t capacity) {
+    builder->capacity = (0 < capacity) ? capacity : 1;
+    builder->data = malloc(builder->capacity);
+    builder->length = 0;
+}
+
+void reserveStringBuilder(StringBuilder *builder, const size_t length) {
+    if (builder->capacity < builder->length + length) {
+        size_t capacity = (0 < builder->capacity) ? builder->capacity : 1;
+        while (capacity < builder->length + length) {
+            capacity *= 2;
+        }
+        builder->data = realloc(builder->data, capacity);
+        builder->capacity = capacity;
+    }
+}
+
+void appendBytes(StringBuilder *builder, const char *bytes, const size_t length) {
+    // An empty run may come with a NULL pointer, which memcpy must not get
+    if (length == 0) {
+        return;
+    }
+    reserveStringBuilder(builder, length);
+    memcpy(builder->data + builder->length, bytes, length);
+    builder->length += length;
+}
+
+void appendString(StringBuilder *builder, const char *string) {
+    appendBytes(builder, string, strlen(string));
+}
+
+void appendCharacter(StringBuilder *builder, const char character) {
+    if (builder->length == builder->capacity) {
+        reserveStringBuilder(builder, 1);
+    }
+    builder->data[builder->length++] = character;
+}
+
+char *builderToString(StringBuilder *builder) {
+    appendCharacter(builder, '\0');
+    char *string = builder->data;
+    builder->data = NULL;
+    builder->length = 0;
+    builder->capacity = 0;
+    return string;
+}
+
+void destroyStringBuilder(StringBuilder *builder) {
+    free(builder->data);
+    builder->data = NULL;
+    builder->length = 0;
+    builder->capacity = 0;
+}
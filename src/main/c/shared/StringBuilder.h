@@ -0,0 +1,60 @@
+#ifndef STRING_BUILDER_HEADER
+#define STRING_BUILDER_HEADER
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A growable byte buffer, which doubles its capacity when an append doesn't
+ * fit. It depends on nothing but the C library, so that the lowest modules
+ * (e.g., "String", which the logger uses) can build strings with it, and the
+ * output sink keeps its buffer in one.
+ *
+ * The builder lives wherever its owner wants it (e.g., on the stack, or in
+ * another struct), and only its data is heap-memory.
+ */
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} StringBuilder;
+
+/**
+ * Starts an empty builder, with room for "capacity" bytes (at least one).
+ */
+void initializeStringBuilder(StringBuilder *builder, const size_t capacity);
+
+/**
+ * Makes room for "length" more bytes, so that the next appends of up to that
+ * many bytes don't grow the buffer.
+ */
+void reserveStringBuilder(StringBuilder *builder, const size_t length);
+
+/**
+ * Appends the bytes. The bytes may be NULL when the length is 0.
+ */
+void appendBytes(StringBuilder *builder, const char *bytes, const size_t length);
+
+/**
+ * Appends a null-terminated string.
+ */
+void appendString(StringBuilder *builder, const char *string);
+
+/**
+ * Appends a single character.
+ */
+void appendCharacter(StringBuilder *builder, const char character);
+
+/**
+ * Null-terminates the content, and hands it over as a string (using
+ * heap-memory, so it must be freed). The builder is left empty, without a
+ * buffer, which the next append allocates again.
+ */
+char *builderToString(StringBuilder *builder);
+
+/**
+ * Frees the buffer of the builder (but not the builder itself).
+ */
+void destroyStringBuilder(StringBuilder *builder);
+
+#endif
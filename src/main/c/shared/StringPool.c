@@ -0,0 +1,79 @@
+#include "StringPool.h"
+
+/* MODULE INTERNAL STATE */
+
+static Logger *_logger = NULL;
+
+void initializeStringPoolModule() { _logger = createLogger("StringPool"); }
+
+void shutdownStringPoolModule() {
+    if (_logger != NULL) {
+        destroyLogger(_logger);
+    }
+}
+
+/* PRIVATE FUNCTIONS */
+
+/**
+ * Returns the atom of the first characters of the text, which ends right there. The shard must be
+ * locked.
+ */
+static char *_internInShard(StringPoolShard *shard, const char *string, size_t length) {
+    char *atom = g_hash_table_lookup(shard->strings, string);
+    if (atom == NULL) {
+        atom = allocateInArena(shard->atoms, length + 1);
+        memcpy(atom, string, length);
+        g_hash_table_add(shard->strings, atom);
+    }
+    return atom;
+}
+
+/* PUBLIC FUNCTIONS */
+
+StringPool *createStringPool() {
+    StringPool *stringPool = calloc(1, sizeof(StringPool));
+    for (int k = 0; k < STRING_POOL_SHARDS; ++k) {
+        g_mutex_init(&stringPool->shards[k].lock);
+        stringPool->shards[k].strings = g_hash_table_new(g_str_hash, g_str_equal);
+        stringPool->shards[k].atoms = createArena();
+    }
+    return stringPool;
+}
+
+char *intern(StringPool *stringPool, const char *string) {
+    StringPoolShard *shard = &stringPool->shards[g_str_hash(string) % STRING_POOL_SHARDS];
+    g_mutex_lock(&shard->lock);
+    char *atom = _internInShard(shard, string, strlen(string));
+    g_mutex_unlock(&shard->lock);
+    return atom;
+}
+
+char *internSlice(StringPool *stringPool, const char *text, size_t length) {
+    // The slice is looked up NUL-terminated, in a buffer of the stack unless it's too long
+    char buffer[256];
+    char *copy = (length < sizeof(buffer)) ? buffer : g_malloc(length + 1);
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+    StringPoolShard *shard = &stringPool->shards[g_str_hash(copy) % STRING_POOL_SHARDS];
+    g_mutex_lock(&shard->lock);
+    char *atom = _internInShard(shard, copy, length);
+    g_mutex_unlock(&shard->lock);
+    if (copy != buffer) {
+        g_free(copy);
+    }
+    return atom;
+}
+
+void destroyStringPool(StringPool *stringPool) {
+    logDebugging(_logger, "Executing destructor: %s", __FUNCTION__);
+    if (stringPool != NULL) {
+        for (int k = 0; k < STRING_POOL_SHARDS; ++k) {
+            logDebugging(_logger, "Releasing %u interned strings of shard %d",
+                         g_hash_table_size(stringPool->shards[k].strings), k);
+            g_hash_table_destroy(stringPool->shards[k].strings);
+            destroyArena(stringPool->shards[k].atoms);
+            g_mutex_clear(&stringPool->shards[k].lock);
+        }
+        free(stringPool);
+    }
+}
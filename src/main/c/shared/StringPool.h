@@ -0,0 +1,64 @@
+#ifndef STRING_POOL_HEADER
+#define STRING_POOL_HEADER
+
+#include "Arena.h"
+#include "Logger.h"
+#include <glib.h>
+#include <stdlib.h>
+
+/**
+ * An intern pool. Every distinct string is stored only once, and the pointer
+ * returned for it (its "atom") is stable during the whole compilation, so
+ * two atoms are equal if and only if their pointers are equal.
+ *
+ * Identifiers, property names and property values are interned by the
+ * lexer, and the rest of the compiler (symbol table, layout and generator)
+ * shares those atoms instead of copying and comparing strings.
+ *
+ * The sections of a program can be scanned at the same time, so the pool is
+ * split in shards by hash, each one with its own lock: scanners only wait
+ * for each other when they intern strings of the same shard. The atoms of a
+ * shard live in its own arena, so they're all released at once.
+ */
+#define STRING_POOL_SHARDS 16
+
+typedef struct {
+    GMutex lock;
+    GHashTable *strings; // key: the atom itself, value: unused
+    Arena *atoms;
+} StringPoolShard;
+
+typedef struct {
+    StringPoolShard shards[STRING_POOL_SHARDS];
+} StringPool;
+
+/** Initialize module's internal state. */
+void initializeStringPoolModule();
+
+/** Shutdown module's internal state. */
+void shutdownStringPoolModule();
+
+/**
+ * Creates an empty pool.
+ */
+StringPool *createStringPool();
+
+/**
+ * Returns the atom of the string, storing a copy of it in the pool if it is
+ * the first time it gets interned. The atom is owned by the pool: it must
+ * not be modified nor freed.
+ */
+char *intern(StringPool *stringPool, const char *string);
+
+/**
+ * Same as "intern", but for the first characters of the text only (which
+ * doesn't have to end there).
+ */
+char *internSlice(StringPool *stringPool, const char *text, size_t length);
+
+/**
+ * Destroys the pool, releasing every atom it owns.
+ */
+void destroyStringPool(StringPool *stringPool);
+
+#endif
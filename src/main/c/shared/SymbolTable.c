@@ -3,6 +3,8 @@
 
 static Logger * _logger = NULL;
 
+#define INITIAL_SYMBOL_BITS 6
+#define INITIAL_SYMBOL_CAPACITY (1 << INITIAL_SYMBOL_BITS)
 
 
 void initializeSemanticsModule() {
@@ -15,75 +17,121 @@ void shutdownSemanticsModule() {
     }
 }
 
-static void freeSymbolTableItem(gpointer item) {
-    if (item != NULL) {
-        SymbolTableItem *symbolItem = (SymbolTableItem *)item;
-        g_array_free(symbolItem->appearsIn, true); 
-        free(symbolItem);
+static void freeSlideObjects(gpointer objects) {
+    if (objects != NULL) {
+        g_hash_table_destroy(objects);
     }
 }
 
+/**
+ * Fibonacci hashing of the address of an atom: the top bits of the product depend on every bit of
+ * the address (the lowest ones are mostly the same for every atom).
+ */
+static guint hashAtom(const char *identifier, guint bits) {
+    const guint64 address = (guint64)(uintptr_t)identifier;
+    return (guint)((address * G_GUINT64_CONSTANT(0x9E3779B97F4A7C15)) >> (64 - bits));
+}
 
-SymbolTable *initializeSymbolTable() {
-    GHashTable * table = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, freeSymbolTableItem);
-    if(table != NULL) {
-        SymbolTable * symbolTable = malloc(sizeof(SymbolTable));
-        if(symbolTable != NULL) {
-            symbolTable->table = table;
-            logDebugging(_logger, "Symbol table initialized successfully");
-            return symbolTable;
-        } else {
-            logError(_logger, "Failed to allocate memory for SymbolTable");
-            g_hash_table_destroy(table);
-            return NULL;
+/**
+ * The slot of the symbol, or the empty slot where it would be.
+ */
+static SymbolSlot *findSlot(SymbolSlot *slots, guint bits, const char *identifier) {
+    const guint mask = (1u << bits) - 1;
+    for (guint slot = hashAtom(identifier, bits);; slot = (slot + 1) & mask) {
+        if (slots[slot].identifier == NULL || slots[slot].identifier == identifier) {
+            return &slots[slot];
+        }
+    }
+}
+
+/**
+ * Doubles the slots of the hashtable and the capacity of the items, which keeps the hashtable at
+ * most half full.
+ */
+static void growSymbolTable(SymbolTable *symbolTable) {
+    const guint slotCount = 1u << symbolTable->slotBits;
+    SymbolSlot *slots = calloc(2 * slotCount, sizeof(SymbolSlot));
+    for (guint slot = 0; slot < slotCount; ++slot) {
+        if (symbolTable->slots[slot].identifier != NULL) {
+            *findSlot(slots, symbolTable->slotBits + 1, symbolTable->slots[slot].identifier) =
+                symbolTable->slots[slot];
         }
     }
+    free(symbolTable->slots);
+    symbolTable->slots = slots;
+    symbolTable->slotBits++;
+    symbolTable->capacity *= 2;
+    symbolTable->items =
+        realloc(symbolTable->items, symbolTable->capacity * sizeof(SymbolTableItem));
+}
+
+
+SymbolTable *initializeSymbolTable() {
+    SymbolTable * symbolTable = calloc(1, sizeof(SymbolTable));
+    if(symbolTable != NULL) {
+        symbolTable->capacity = INITIAL_SYMBOL_CAPACITY;
+        symbolTable->items = malloc(INITIAL_SYMBOL_CAPACITY * sizeof(SymbolTableItem));
+        symbolTable->slots = calloc(2 * INITIAL_SYMBOL_CAPACITY, sizeof(SymbolSlot));
+        symbolTable->slotBits = INITIAL_SYMBOL_BITS + 1;
+        symbolTable->slides = g_ptr_array_new_with_free_func(freeSlideObjects);
+        logDebugging(_logger, "Symbol table initialized successfully");
+        return symbolTable;
+    }
     else {
-        logError(_logger, "Failed to create symbol table");
+        logError(_logger, "Failed to allocate memory for SymbolTable");
         return NULL;
     }
 }
 
 
-void addSymbol(SymbolTable *symbolTable, const char *identifier, ObjectType type) {
+SymbolId addSymbol(SymbolTable *symbolTable, const char *identifier, ObjectType type) {
     logDebugging(_logger, "Adding symbol: %s of type %d", identifier, type);
     if (symbolTable == NULL || identifier == NULL) {
         logError(_logger, "Cannot add symbol: symbolTable or identifier is NULL");
-        return;
+        return NO_SYMBOL;
     }
-    
+
     // Check if the symbol already exists
-    if (symbolExists(symbolTable, identifier)) {
+    SymbolSlot *slot = findSlot(symbolTable->slots, symbolTable->slotBits, identifier);
+    if (slot->identifier != NULL) {
         logDebugging(_logger, "Symbol %s already exists in the symbol table", identifier);
-        return;
+        return slot->symbol;
     }
-
-    SymbolTableItem *item = malloc(sizeof(SymbolTableItem));
-    if (item != NULL) {
-        item->type = type;
-        item->currentSlide = -1; // Initialize currentSlide to -1 (not assigned)
-        item->appearsIn = g_array_new(false, true, sizeof(int)); 
-        g_hash_table_insert(symbolTable->table, g_strdup(identifier), item);
-    } else {
-        logError(_logger, "Failed to allocate memory for SymbolTableItem");
+    if (symbolTable->count == symbolTable->capacity) {
+        growSymbolTable(symbolTable);
+        slot = findSlot(symbolTable->slots, symbolTable->slotBits, identifier);
     }
+
+    SymbolId symbol = symbolTable->count++;
+    SymbolTableItem *item = &symbolTable->items[symbol];
+    item->identifier = (char *)identifier;
+    item->type = type;
+    item->string = (Slice){NULL, 0};
+    item->currentSlide = -1; // Initialize currentSlide to -1 (not assigned)
+    item->properties = NULL;
+    slot->identifier = identifier;
+    slot->symbol = symbol;
+    return symbol;
 }
 
-SymbolTableItem *getSymbol(SymbolTable *symbolTable, const char *identifier) {
-    logDebugging(_logger, "Retrieving symbol for identifier: %s", identifier);
+SymbolId findSymbol(SymbolTable *symbolTable, const char *identifier) {
     if (symbolTable == NULL || identifier == NULL) {
-        logError(_logger, "Cannot retrieve symbol: symbolTable or identifier is NULL");
-        return NULL;
+        logError(_logger, "Cannot resolve symbol: symbolTable or identifier is NULL");
+        return NO_SYMBOL;
     }
+    SymbolSlot *slot = findSlot(symbolTable->slots, symbolTable->slotBits, identifier);
+    return (slot->identifier == NULL) ? NO_SYMBOL : slot->symbol;
+}
 
-    SymbolTableItem *item = g_hash_table_lookup(symbolTable->table, identifier);
-    if (item != NULL) {
-        logDebugging(_logger, "Symbol %s found in the symbol table with type %d", identifier, item->type);
-        return item;
-    } else {
-        logDebugging(_logger, "Symbol %s not found in the symbol table", identifier);
+SymbolTableItem *getSymbolById(SymbolTable *symbolTable, SymbolId symbol) {
+    if (symbol < 0 || symbolTable->count <= symbol) {
         return NULL;
     }
+    return &symbolTable->items[symbol];
+}
+
+SymbolTableItem *getSymbol(SymbolTable *symbolTable, const char *identifier) {
+    return getSymbolById(symbolTable, findSymbol(symbolTable, identifier));
 }
 
 
@@ -101,19 +149,43 @@ int getSymbolCurrentSlide(SymbolTable *symbolTable, const char *identifier) {
     return item->currentSlide;
 }
 
-boolean symbolExists(SymbolTable *symbolTable, const char *identifier) {
-    logDebugging(_logger, "Checking if symbol exists: %s", identifier);
-    if (symbolTable == NULL || identifier == NULL) {
-        logError(_logger, "Cannot check symbol existence: symbolTable or identifier is NULL");
+void reserveSlides(SymbolTable *symbolTable, int slideCount) {
+    if (symbolTable->slides->len < slideCount) {
+        g_ptr_array_set_size(symbolTable->slides, slideCount);
+    }
+}
+
+boolean addToSlide(SymbolTable *symbolTable, int slide, SymbolId symbol) {
+    logDebugging(_logger, "Adding symbol %d to slide %d", symbol, slide);
+    if (symbolTable->slides->len <= slide) {
+        g_ptr_array_set_size(symbolTable->slides, slide + 1);
+    }
+    GHashTable *objects = g_ptr_array_index(symbolTable->slides, slide);
+    if (objects == NULL) {
+        objects = g_hash_table_new(g_direct_hash, g_direct_equal);
+        g_ptr_array_index(symbolTable->slides, slide) = objects;
+    }
+    return g_hash_table_add(objects, GINT_TO_POINTER(symbol));
+}
+
+boolean isInSlide(SymbolTable *symbolTable, int slide, SymbolId symbol) {
+    if (slide < 0 || symbolTable->slides->len <= slide) {
         return false;
     }
-    return g_hash_table_contains(symbolTable->table, identifier);
+    GHashTable *objects = g_ptr_array_index(symbolTable->slides, slide);
+    return objects != NULL && g_hash_table_contains(objects, GINT_TO_POINTER(symbol));
+}
+
+boolean symbolExists(SymbolTable *symbolTable, const char *identifier) {
+    return findSymbol(symbolTable, identifier) != NO_SYMBOL;
 }
 
 void destroySymbolTable(SymbolTable *symbolTable) {
     logDebugging(_logger, "Executing destructor: %s", __FUNCTION__);
     if (symbolTable != NULL) {
-        g_hash_table_destroy(symbolTable->table);
+        free(symbolTable->items);
+        free(symbolTable->slots);
+        g_ptr_array_free(symbolTable->slides, true);
         free(symbolTable);
         logDebugging(_logger, "Symbol table destroyed successfully");
     } else {
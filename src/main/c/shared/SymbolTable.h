@@ -2,6 +2,7 @@
 
 #define SYMBOL_TABLE_HEADER
 
+#include "Arena.h"
 #include "Logger.h"
 #include "String.h"
 #include "Type.h"
@@ -9,27 +10,40 @@
 #include <stdlib.h>
 
 /**
- * For simplicity of implementation, we use glib implementation of hashtables to store the
- *key-values of the symbol table We hide the implementation details of the symbol table using a
- *struct
- **/
-
-/**
- * Variable are stored in a hashtable, where the key is the identifier of the variable and the value
- * is a type.
+ * Every symbol gets a dense integer ID when it's added (0 for the first one, 1 for the next one,
+ * and so on), which is the index of its item in a contiguous array. Identifiers are atoms of the
+ * compilation's string pool, so they are resolved into IDs by an open-addressing hashtable (with
+ * linear probing) that hashes and compares their addresses, and the table doesn't own them.
+ *
+ * Identifiers are resolved once, by the semantic analysis, and the later phases carry the IDs.
  */
 
 typedef struct {
-    ObjectType type; // Type of the symbol
-    char *string;    // owned by ast, for imgs and texblocks
+    char *identifier; // atom of the symbol
+    ObjectType type;  // Type of the symbol
+    Slice string;     // slice of the source text, for imgs and texblocks
     int currentSlide;
-    GArray *appearsIn; /* list of slides where it appears ( for semantics in animation for
-                          animations) */
-    CssProperty *properties;
+    ArenaArray *properties; // Of CssProperty, owned by the AST
 } SymbolTableItem;
 
+// A slot of the hashtable, which keeps the atom so that probing doesn't touch the items
 typedef struct {
-    GHashTable *table; // The hashtable that contains the symbols
+    const char *identifier; // NULL if the slot is empty
+    SymbolId symbol;
+} SymbolSlot;
+
+/**
+ * The objects of each slide (for semantics in positioning and animations) are a set of their IDs,
+ * created when the first object is added to the slide, so the membership of an object is checked
+ * in constant time and it takes memory only for the objects actually added.
+ */
+typedef struct {
+    SymbolTableItem *items; // index: symbol ID
+    int count;
+    int capacity;
+    SymbolSlot *slots; // The hashtable of IDs
+    guint slotBits;    // The number of slots is 2 ^ slotBits
+    GPtrArray *slides; // index: slide number, value: set of IDs (NULL if it's empty)
 } SymbolTable;
 
 /* To log semantic errors as suck  */
@@ -46,12 +60,29 @@ void shutdownSemanticsModule();
 SymbolTable *initializeSymbolTable();
 
 /**
- * Adds a symbol to the symbol table.
+ * Adds a symbol to the symbol table. Every item retrieved before is invalid after it.
  * @param symbolTable The symbol table to add the symbol to.
  * @param identifier The identifier of the symbol.
- * @param item The SymbolTableItem to add.
+ * @param type The type of the symbol.
+ * @return The ID of the symbol (the one it already had, if it exists).
  */
-void addSymbol(SymbolTable *symbolTable, const char *identifier, ObjectType type);
+SymbolId addSymbol(SymbolTable *symbolTable, const char *identifier, ObjectType type);
+
+/**
+ * Resolves the ID of a symbol.
+ * @param symbolTable The symbol table to retrieve the symbol from.
+ * @param identifier The identifier of the symbol to resolve.
+ * @return The ID of the symbol if found, NO_SYMBOL otherwise.
+ */
+SymbolId findSymbol(SymbolTable *symbolTable, const char *identifier);
+
+/**
+ * Retrieves a symbol from the symbol table, by ID.
+ * @param symbolTable The symbol table to retrieve the symbol from.
+ * @param symbol The ID of the symbol to retrieve.
+ * @return The SymbolTableItem if found, NULL otherwise.
+ */
+SymbolTableItem *getSymbolById(SymbolTable *symbolTable, SymbolId symbol);
 
 /**
  * Retrieves a symbol from the symbol table.
@@ -77,6 +108,32 @@ ObjectType getSymbolType(SymbolTable *symbolTable, const char *identifier);
  */
 int getSymbolCurrentSlide(SymbolTable *symbolTable, const char *identifier);
 
+/**
+ * Makes room for the given number of slides, so that objects can be added to different slides from
+ * different threads at the same time (each slide from a single thread).
+ * @param symbolTable The symbol table.
+ * @param slideCount The number of slides.
+ */
+void reserveSlides(SymbolTable *symbolTable, int slideCount);
+
+/**
+ * Adds an object to a slide.
+ * @param symbolTable The symbol table to add the object to.
+ * @param slide The number of the slide.
+ * @param symbol The ID of the object.
+ * @return False if the object was already in the slide, true otherwise.
+ */
+boolean addToSlide(SymbolTable *symbolTable, int slide, SymbolId symbol);
+
+/**
+ * Checks if an object was added to a slide.
+ * @param symbolTable The symbol table to check.
+ * @param slide The number of the slide (which may not exist, like -1).
+ * @param symbol The ID of the object.
+ * @return True if the object is in the slide, false otherwise.
+ */
+boolean isInSlide(SymbolTable *symbolTable, int slide, SymbolId symbol);
+
 /**
  * Checks if a symbol exists in the symbol table.
  * @param symbolTable The symbol table to check.
@@ -1,56 +1,171 @@
 #ifndef TYPE_HEADER
 #define TYPE_HEADER
 #include <glib.h>
+#include <stdint.h>
 
 typedef enum { false = 0, true = 1 } boolean;
 
 typedef enum { OBJ_SLIDE, OBJ_TEXTBLOCK, OBJ_IMAGE, OBJ_UNKNOWN } ObjectType;
 
+// Dense ID of a symbol: the index of its item in the symbol table (see SymbolTable.h)
+typedef int SymbolId;
+#define NO_SYMBOL (-1)
+
 // Property value types
-typedef enum { PROP_VAL_IDENTIFIER, PROP_VAL_INTEGER, PROP_VAL_DECIMAL } PropertyValueType;
+typedef enum {
+    PROP_VAL_IDENTIFIER,
+    PROP_VAL_INTEGER,
+    PROP_VAL_DECIMAL,
+    PROP_VAL_LENGTH,
+    PROP_VAL_COLOR
+} PropertyValueType;
+
+// Units of a CSS length (see CssValue.h)
+typedef enum {
+    UNIT_CH,
+    UNIT_CM,
+    UNIT_EM,
+    UNIT_EX,
+    UNIT_IN,
+    UNIT_MM,
+    UNIT_PC,
+    UNIT_PT,
+    UNIT_PX,
+    UNIT_REM,
+    UNIT_VH,
+    UNIT_VMAX,
+    UNIT_VMIN,
+    UNIT_VW
+} LengthUnit;
+
+// A CSS length, with the digits as written: "1.50px" is {150, 2, UNIT_PX}
+typedef struct {
+    int64_t digits;
+    int decimals; // Digits after the decimal point
+    LengthUnit unit;
+} Length;
+
+// A CSS color, packed as 0xRRGGBBAA
+typedef uint32_t Color;
+
+// The objects a property applies to, and the kinds of values it accepts (see PROPERTY_SCHEMA)
+#define ON_SLIDE (1 << OBJ_SLIDE)
+#define ON_TEXTBLOCK (1 << OBJ_TEXTBLOCK)
+#define ON_IMAGE (1 << OBJ_IMAGE)
+#define VALUE_KEYWORD (1 << PROP_VAL_IDENTIFIER)
+#define VALUE_INTEGER (1 << PROP_VAL_INTEGER)
+#define VALUE_DECIMAL (1 << PROP_VAL_DECIMAL)
+#define VALUE_LENGTH (1 << PROP_VAL_LENGTH)
+#define VALUE_COLOR (1 << PROP_VAL_COLOR)
+#define COLOR_VALUES (VALUE_KEYWORD | VALUE_COLOR)
+#define SIZE_VALUES (VALUE_KEYWORD | VALUE_LENGTH | VALUE_INTEGER)
+
+// Every property the presentations accept, one row each: its key, its name, the objects it applies
+// to, and the kinds of values it accepts (see PropertySchema.h). Any other property is ignored.
+#define PROPERTY_SCHEMA(PROPERTY)                                                                  \
+    PROPERTY(PROP_BACKGROUND_COLOR, "background-color", ON_SLIDE | ON_TEXTBLOCK, COLOR_VALUES)     \
+    PROPERTY(PROP_BORDER_COLOR, "border-color", ON_IMAGE, COLOR_VALUES)                            \
+    PROPERTY(PROP_BORDER_RADIUS, "border-radius", ON_IMAGE, SIZE_VALUES)                           \
+    PROPERTY(PROP_BORDER_STYLE, "border-style", ON_IMAGE, VALUE_KEYWORD)                           \
+    PROPERTY(PROP_BORDER_WIDTH, "border-width", ON_IMAGE, SIZE_VALUES)                             \
+    PROPERTY(PROP_COLOR, "color", ON_TEXTBLOCK, COLOR_VALUES)                                      \
+    PROPERTY(PROP_FONT_FAMILY, "font-family", ON_SLIDE | ON_TEXTBLOCK, VALUE_KEYWORD)              \
+    PROPERTY(PROP_FONT_SIZE, "font-size", ON_TEXTBLOCK, SIZE_VALUES)                               \
+    PROPERTY(PROP_MAX_HEIGHT, "max-height", ON_IMAGE, SIZE_VALUES)                                 \
+    PROPERTY(PROP_MAX_WIDTH, "max-width", ON_IMAGE, SIZE_VALUES)
+
+#define PROPERTY_KEY(key, name, objects, values) key,
+typedef enum { PROPERTY_SCHEMA(PROPERTY_KEY) PROP_UNKNOWN } PropertyKey;
+#undef PROPERTY_KEY
 
 // Struct for a CSS property: property name and value
 typedef struct CssProperty {
     char *property_name; // PROPERTY token text
+    PropertyKey key;     // Resolved once, when the property gets parsed
     PropertyValueType value_type;
     union value {
         char *identifier;
         int integer;
         float decimal;
+        Length length;
+        Color color;
     } value;
-    struct CssProperty *next;
 } CssProperty;
 
 typedef struct PositionedObject {
-    char *identifier;
+    char *identifier; // atom, owned by the string pool
+    SymbolId symbol;
     int row;
     int col;
 } PositionedObject;
 
+// An occupied cell of a row
+typedef struct GridCell {
+    int col;
+    PositionedObject *object;
+} GridCell;
+
+// Most rows hold a single object, so the first ones are kept in the row itself
+#define ROW_INLINE_CELLS 2
+
 typedef struct Row {
-    GHashTable *columns; // key: int* -> column index, value: PositionedObject*
+    int count;                        // Occupied cells
+    GridCell cells[ROW_INLINE_CELLS]; // Every cell, while they fit (unsorted)
+    GHashTable *columns; // key: column index, value: PositionedObject* (NULL while the cells fit)
     int minCol;
     int maxCol;
 } Row;
 
+// What happens to an object placed where another object already is
+typedef enum {
+    COLLISION_SHIFT, // It moves on, in the direction it was placed, to the first free cell
+    COLLISION_ERROR  // It's left out, and the layout fails
+} CollisionPolicy;
+
+// The resolved layout of a slide, row-major: the cells of the k-th row (from the highest to the
+// lowest) are cells[rowOffsets[k]] to cells[rowOffsets[k + 1] - 1], sorted by column
+typedef struct Grid {
+    int rowCount;
+    int *rows;       // rowCount row indexes
+    int *rowOffsets; // rowCount + 1 offsets into the cells
+    GridCell *cells;
+} Grid;
+
+// Owns the objects and the rows of the slides (see Arena.h)
+struct Arena;
+
 typedef struct Slide {
-    char *identifier; // To then gather the properties
-    GHashTable *rows; // key: row index, value: Row*
+    char *identifier;    // To then gather the properties
+    struct Arena *arena; // Where it lives, with its objects and rows: the arena of its layout
+                         // worker, and the one of the list once the workers are merged into it
+    GHashTable *rows;    // key: row index, value: Row* (NULL once the grid is frozen)
+    Grid grid;
     int minRow;
     int maxRow;
     int minCol;
     int maxCol;
-    GHashTable *symbolToObject; // value: PositionedObject*
+    GHashTable *symbolToObject; // key: SymbolId, value: PositionedObject* (NULL once frozen)
+    CollisionPolicy collisionPolicy;
+    int collisionErrors; // Objects left out of the grid by a collision
+    GPtrArray *diagnostics; // Of its warnings and errors, logged in slide order after the layout
     struct Slide *next;
 } Slide;
 
 typedef struct {
     Slide *head;
     Slide *tail;
+    int errorCount;      // Layout errors, over every slide
+    struct Arena *arena; // Every slide, object, row and grid of the list
 } SlideList;
 
 typedef int Token;
 
+// A piece of the source text: it isn't NUL-terminated (print it with "%.*s"), and it isn't owned
+typedef struct {
+    const char *text; // NULL if none
+    int length;
+} Slice;
+
 typedef enum {
     POS_TOP,
     POS_BOTTOM,